@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ConfigWatcher.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::ConfigWatcher;
+using kelo::yaml_common::FrozenTree;
+
+/**
+ * @brief Config file with `size` parameters, taking a few milliseconds to
+ * parse
+ */
+static std::string writeConfig(size_t size)
+{
+    const std::string file_path = "/tmp/config_watcher_benchmark.yaml";
+    std::ofstream file(file_path);
+    for ( size_t i = 0; i < size; i++ )
+    {
+        file << "param_" << i << ": " << 0.5 * i << "\n";
+    }
+    return file_path;
+}
+
+/**
+ * @brief Run `reload` in a loop on a background thread while the benchmark
+ * measures the latency of `read`; reports the mean and the maximum latency
+ */
+template <typename Reload, typename Read>
+static void measureReads(benchmark::State& state, bool is_reloading,
+                         Reload reload, Read read)
+{
+    std::atomic<bool> is_done{false};
+    std::atomic<size_t> num_of_reloads{0};
+    std::thread reloader([&]()
+    {
+        while ( is_reloading && !is_done )
+        {
+            reload();
+            num_of_reloads++;
+        }
+    });
+
+    double max_ns = 0.0;
+    for ( auto _ : state )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(read());
+        const std::chrono::duration<double, std::nano> latency =
+            std::chrono::steady_clock::now() - start;
+        max_ns = std::max(max_ns, latency.count());
+    }
+    is_done = true;
+    reloader.join();
+    state.counters["max_ns"] = max_ns;
+    state.counters["reloads"] = static_cast<double>(num_of_reloads.load());
+}
+
+static void BM_configWatcherRead(benchmark::State& state)
+{
+    ConfigWatcher watcher(writeConfig(state.range(1)), nullptr);
+    watcher.reload();
+    measureReads(state, state.range(0) != 0,
+                 [&watcher]() { watcher.reload(); },
+                 [&watcher]()
+                 {
+                     return Parser::get<double>(watcher.current()->root(), "param_7", 0.0);
+                 });
+}
+BENCHMARK(BM_configWatcherRead)->ArgNames({"reloading", "params"})
+    ->Args({0, 1000})->Args({1, 1000});
+
+/**
+ * @brief Naive hot reload for comparison: the current node is replaced under
+ * a mutex which readers take as well, so parsing blocks them
+ */
+static void BM_mutexSwapRead(benchmark::State& state)
+{
+    const std::string file_path = writeConfig(state.range(1));
+    std::mutex mutex;
+    YAML::Node current;
+    Parser::loadFile(file_path, current, false);
+    measureReads(state, state.range(0) != 0,
+                 [&]()
+                 {
+                     std::lock_guard<std::mutex> lock(mutex);
+                     Parser::loadFile(file_path, current, false);
+                 },
+                 [&]()
+                 {
+                     std::lock_guard<std::mutex> lock(mutex);
+                     return Parser::get<double>(current, "param_7", 0.0);
+                 });
+}
+BENCHMARK(BM_mutexSwapRead)->ArgNames({"reloading", "params"})
+    ->Args({0, 1000})->Args({1, 1000});
@@ -0,0 +1,199 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/KeyFilter.h>
+#include <yaml_common/Parser.h>
+
+using LegacyParser = kelo::yaml_common::Parser;
+
+/**
+ * @brief Map document with `size` entries of mixed scalar types, nested maps
+ * and sequences as found in robot configuration files
+ */
+static YAML::Node mixedDocument(size_t size)
+{
+    YAML::Node root;
+    for ( size_t i = 0; i < size; i++ )
+    {
+        YAML::Node entry;
+        entry["id"] = i;
+        entry["name"] = "component_" + std::to_string(i);
+        entry["gain"] = 0.125 * i;
+        entry["enabled"] = ( i % 2 == 0 );
+        entry["limits"].push_back(-1.5);
+        entry["limits"].push_back(2.5);
+        entry["limits"].push_back("auto");
+        root["component_" + std::to_string(i)] = entry;
+    }
+    return YAML::Load(YAML::Dump(root));
+}
+
+/**
+ * @brief copyYaml as it was before scalar classification: one full
+ * conversion attempt per candidate type
+ */
+static void copyYamlByChain(const YAML::Node& values, YAML::Emitter& yaml)
+{
+    for ( const auto& entry : values )
+    {
+        const YAML::Node& value = ( values.IsMap() ) ? entry.second : entry;
+        if ( values.IsMap() )
+        {
+            yaml << YAML::Key << entry.first.as<std::string>() << YAML::Value;
+        }
+        if ( value.IsScalar() )
+        {
+            if ( LegacyParser::hasInt(value) )
+            {
+                yaml << LegacyParser::getInt(value);
+            }
+            else if ( LegacyParser::hasDouble(value) )
+            {
+                yaml << LegacyParser::getDouble(value);
+            }
+            else if ( LegacyParser::hasBool(value) )
+            {
+                yaml << LegacyParser::getBool(value);
+            }
+            else
+            {
+                yaml << LegacyParser::getString(value);
+            }
+        }
+        else
+        {
+            yaml << ( ( value.IsMap() ) ? YAML::BeginMap : YAML::BeginSeq );
+            copyYamlByChain(value, yaml);
+            yaml << ( ( value.IsMap() ) ? YAML::EndMap : YAML::EndSeq );
+        }
+    }
+}
+
+static void BM_copyYamlByChain(benchmark::State& state)
+{
+    const YAML::Node root = mixedDocument(state.range(0));
+    for ( auto _ : state )
+    {
+        YAML::Emitter yaml;
+        yaml << YAML::BeginMap;
+        copyYamlByChain(root, yaml);
+        yaml << YAML::EndMap;
+        benchmark::DoNotOptimize(yaml.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 7);
+}
+BENCHMARK(BM_copyYamlByChain)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_copyYaml(benchmark::State& state)
+{
+    const YAML::Node root = mixedDocument(state.range(0));
+    for ( auto _ : state )
+    {
+        YAML::Emitter yaml;
+        yaml << YAML::BeginMap;
+        LegacyParser::copyYaml(root, yaml);
+        yaml << YAML::EndMap;
+        benchmark::DoNotOptimize(yaml.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 7);
+}
+BENCHMARK(BM_copyYaml)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Document of `size` components, each with a large "raw" blob, copied
+ * without the blobs
+ */
+static YAML::Node blobDocument(size_t size)
+{
+    YAML::Node root = mixedDocument(size);
+    for ( size_t i = 0; i < size; i++ )
+    {
+        YAML::Node raw = root["component_" + std::to_string(i)]["raw"];
+        for ( size_t j = 0; j < 256; j++ )
+        {
+            raw.push_back(j);
+        }
+    }
+    return root;
+}
+
+static void BM_copyYamlSkipBlobsAfterCopy(benchmark::State& state)
+{
+    const YAML::Node root = blobDocument(state.range(0));
+    for ( auto _ : state )
+    {
+        /* without nested skipping, blobs were stripped from a copy */
+        YAML::Node stripped = YAML::Clone(root);
+        for ( size_t i = 0; i < static_cast<size_t>(state.range(0)); i++ )
+        {
+            stripped["component_" + std::to_string(i)].remove("raw");
+        }
+        YAML::Emitter yaml;
+        yaml << YAML::BeginMap;
+        LegacyParser::copyYaml(stripped, yaml);
+        yaml << YAML::EndMap;
+        benchmark::DoNotOptimize(yaml.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_copyYamlSkipBlobsAfterCopy)->Arg(100)->Unit(benchmark::kMillisecond);
+
+static void BM_copyYamlKeyFilterKey(benchmark::State& state)
+{
+    const YAML::Node root = blobDocument(state.range(0));
+    kelo::yaml_common::KeyFilter filter;
+    filter.addKey("raw");
+    for ( auto _ : state )
+    {
+        YAML::Emitter yaml;
+        yaml << YAML::BeginMap;
+        LegacyParser::copyYaml(root, yaml, filter);
+        yaml << YAML::EndMap;
+        benchmark::DoNotOptimize(yaml.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_copyYamlKeyFilterKey)->Arg(100)->Unit(benchmark::kMillisecond);
+
+static void BM_copyYamlKeyFilterPath(benchmark::State& state)
+{
+    const YAML::Node root = blobDocument(state.range(0));
+    kelo::yaml_common::KeyFilter filter;
+    filter.addPath("*/raw");
+    for ( auto _ : state )
+    {
+        YAML::Emitter yaml;
+        yaml << YAML::BeginMap;
+        LegacyParser::copyYaml(root, yaml, filter);
+        yaml << YAML::EndMap;
+        benchmark::DoNotOptimize(yaml.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_copyYamlKeyFilterPath)->Arg(100)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Root level skipping with many keys, linear scan of the skip list
+ * before the hashed filter
+ */
+static void BM_copyYamlSkipKeys(benchmark::State& state)
+{
+    const YAML::Node root = mixedDocument(1000);
+    std::vector<std::string> skip_keys;
+    for ( size_t i = 0; i < static_cast<size_t>(state.range(0)); i++ )
+    {
+        skip_keys.push_back("unused_" + std::to_string(i));
+    }
+    for ( auto _ : state )
+    {
+        YAML::Emitter yaml;
+        yaml << YAML::BeginMap;
+        LegacyParser::copyYaml(root, yaml, skip_keys);
+        yaml << YAML::EndMap;
+        benchmark::DoNotOptimize(yaml.size());
+    }
+}
+BENCHMARK(BM_copyYamlSkipKeys)->Arg(1)->Arg(256)->Unit(benchmark::kMillisecond);
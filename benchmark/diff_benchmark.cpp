@@ -0,0 +1,93 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::FrozenTree;
+using kelo::yaml_common::PathChange;
+
+/**
+ * @brief Config with `num_of_groups` maps of parameters; `changed_group`
+ * gets a different value for one of its parameters
+ */
+static std::string configYaml(size_t num_of_groups, size_t changed_group)
+{
+    YAML::Node node;
+    for ( size_t i = 0; i < num_of_groups; i++ )
+    {
+        YAML::Node group;
+        for ( size_t j = 0; j < 16; j++ )
+        {
+            group["param_" + std::to_string(j)] = 0.5 * j;
+        }
+        group["limits"] = std::vector<double>{-1.0, 1.0, -2.0, 2.0};
+        if ( i == changed_group )
+        {
+            group["param_3"] = 42.0;
+        }
+        node["group_" + std::to_string(i)] = group;
+    }
+    return YAML::Dump(node);
+}
+
+/**
+ * @brief Reload that changes one parameter, diffed on YAML::Node: only
+ * identical nodes can be skipped, so every scalar is compared
+ */
+static void BM_diffYAML(benchmark::State& state)
+{
+    const size_t num_of_groups = state.range(0);
+    const YAML::Node old_config = YAML::Load(configYaml(num_of_groups, num_of_groups));
+    const YAML::Node new_config = YAML::Load(configYaml(num_of_groups, num_of_groups / 2));
+    std::vector<PathChange> changes;
+    for ( auto _ : state )
+    {
+        changes.clear();
+        Parser::diffYAML(old_config, new_config, changes);
+        benchmark::DoNotOptimize(changes.data());
+    }
+    state.counters["changes"] = changes.size();
+}
+BENCHMARK(BM_diffYAML)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Same reload diffed on FrozenTree: unchanged groups are skipped by
+ * their hash
+ */
+static void BM_diffFrozen(benchmark::State& state)
+{
+    const size_t num_of_groups = state.range(0);
+    const FrozenTree old_config(YAML::Load(configYaml(num_of_groups, num_of_groups)));
+    const FrozenTree new_config(YAML::Load(configYaml(num_of_groups, num_of_groups / 2)));
+    std::vector<PathChange> changes;
+    for ( auto _ : state )
+    {
+        changes.clear();
+        Parser::diffYAML(old_config.root(), new_config.root(), changes);
+        benchmark::DoNotOptimize(changes.data());
+    }
+    state.counters["changes"] = changes.size();
+    state.counters["nodes"] = new_config.numOfNodes();
+}
+BENCHMARK(BM_diffFrozen)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Cost of freezing the new version for reference, paid once per
+ * reload by ConfigWatcher anyway
+ */
+static void BM_diffFreeze(benchmark::State& state)
+{
+    const YAML::Node config = YAML::Load(configYaml(state.range(0), 0));
+    for ( auto _ : state )
+    {
+        FrozenTree tree(config);
+        benchmark::DoNotOptimize(tree.numOfNodes());
+    }
+}
+BENCHMARK(BM_diffFreeze)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,288 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using LegacyParser = kelo::yaml_common::Parser;
+
+/*
+ * Benchmarks of the public API on generated documents. The number of
+ * entries of the documents is set with the environment variable
+ * YAML_COMMON_BENCHMARK_SIZES as a comma separated list (default "16,1024"),
+ * e.g. to compare two versions of yaml_common on the size of your configs:
+ *
+ *     YAML_COMMON_BENCHMARK_SIZES=100,10000 yaml_common_benchmarks \
+ *         --benchmark_filter=BM_document --benchmark_out=results.json \
+ *         --benchmark_out_format=json
+ */
+
+/**
+ * @brief Add the document sizes of YAML_COMMON_BENCHMARK_SIZES as arguments
+ */
+static void documentSizes(benchmark::internal::Benchmark* benchmark)
+{
+    const char* sizes = std::getenv("YAML_COMMON_BENCHMARK_SIZES");
+    std::stringstream stream(( sizes != nullptr ) ? sizes : "16,1024");
+    std::string size;
+    while ( std::getline(stream, size, ',') )
+    {
+        const long value = std::strtol(size.c_str(), nullptr, 10);
+        if ( value > 0 )
+        {
+            benchmark->Arg(value);
+        }
+    }
+}
+
+/**
+ * @brief Config map of `size` parameter groups with the kinds of values our
+ * configs contain; `offset` shifts all values
+ */
+static YAML::Node createDocument(size_t size, double offset = 0.0)
+{
+    YAML::Node node(YAML::NodeType::Map);
+    for ( size_t i = 0; i < size; i++ )
+    {
+        YAML::Node group;
+        group["id"] = static_cast<int>(i);
+        group["gain"] = offset + 0.01 * i;
+        group["enabled"] = ( i % 2 == 0 );
+        group["frame"] = "sensor_" + std::to_string(i);
+        group["x"] = offset + 1.5;
+        group["y"] = offset - 2.25;
+        group["z"] = offset + 0.125;
+        group["roll"] = 0.0;
+        group["pitch"] = 0.7853981633974483;
+        group["yaw"] = offset + 3.14159;
+        group["limits"] = std::vector<double>{-1.0, 1.0, -2.0 - offset, 2.0 + offset};
+        node.force_insert("group_" + std::to_string(i), group);
+    }
+    return YAML::Load(YAML::Dump(node));
+}
+
+static void BM_documentRead(benchmark::State& state)
+{
+    const YAML::Node document = createDocument(state.range(0));
+    for ( auto _ : state )
+    {
+        for ( const auto& entry : document )
+        {
+            int id;
+            double gain;
+            bool enabled;
+            std::string frame;
+            std::vector<double> limits;
+            benchmark::DoNotOptimize(Parser::read(entry.second, "id", id, false));
+            benchmark::DoNotOptimize(Parser::read(entry.second, "gain", gain, false));
+            benchmark::DoNotOptimize(Parser::read(entry.second, "enabled", enabled, false));
+            benchmark::DoNotOptimize(Parser::read(entry.second, "frame", frame, false));
+            benchmark::DoNotOptimize(Parser::read(entry.second, "limits", limits, false));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 5);
+}
+BENCHMARK(BM_documentRead)->Apply(documentSizes);
+
+static void BM_documentHas(benchmark::State& state)
+{
+    const YAML::Node document = createDocument(state.range(0));
+    for ( auto _ : state )
+    {
+        for ( const auto& entry : document )
+        {
+            benchmark::DoNotOptimize(Parser::has<double>(entry.second, "gain"));
+            benchmark::DoNotOptimize(Parser::has<int>(entry.second, "frame"));
+            benchmark::DoNotOptimize(Parser::has<int>(entry.second, "missing"));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 3);
+}
+BENCHMARK(BM_documentHas)->Apply(documentSizes);
+
+static void BM_documentGet(benchmark::State& state)
+{
+    const YAML::Node document = createDocument(state.range(0));
+    for ( auto _ : state )
+    {
+        for ( const auto& entry : document )
+        {
+            benchmark::DoNotOptimize(Parser::get<double>(entry.second, "gain", 0.0));
+            benchmark::DoNotOptimize(Parser::get<std::string>(entry.second, "frame", ""));
+            benchmark::DoNotOptimize(Parser::get<int>(entry.second, "missing", -1));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 3);
+}
+BENCHMARK(BM_documentGet)->Apply(documentSizes);
+
+static void BM_documentReadFloats(benchmark::State& state)
+{
+    const YAML::Node document = createDocument(state.range(0));
+    const std::vector<std::string> keys{"x", "y", "z", "roll", "pitch", "yaw"};
+    std::vector<float> values;
+    for ( auto _ : state )
+    {
+        for ( const auto& entry : document )
+        {
+            benchmark::DoNotOptimize(Parser::readFloats(entry.second, keys, values, false));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * keys.size());
+}
+BENCHMARK(BM_documentReadFloats)->Apply(documentSizes);
+
+/**
+ * @brief Override with half of the groups of the base and different values
+ */
+static void BM_documentMergeYAML(benchmark::State& state)
+{
+    const YAML::Node base = createDocument(state.range(0));
+    const YAML::Node override_node = createDocument(state.range(0) / 2, 1.0);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::mergeYAML(base, override_node));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_documentMergeYAML)->Apply(documentSizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_documentLoadFile(benchmark::State& state)
+{
+    const std::string file_path = "/tmp/yaml_common_document_benchmark_"
+                                  + std::to_string(state.range(0)) + ".yaml";
+    const std::string text = YAML::Dump(createDocument(state.range(0)));
+    std::ofstream(file_path) << text;
+    for ( auto _ : state )
+    {
+        YAML::Node node;
+        if ( !Parser::loadFile(file_path, node, false) )
+        {
+            state.SkipWithError("could not load file");
+            break;
+        }
+        benchmark::DoNotOptimize(node);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    std::remove(file_path.c_str());
+}
+BENCHMARK(BM_documentLoadFile)->Apply(documentSizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_documentCopyYaml(benchmark::State& state)
+{
+    const YAML::Node document = createDocument(state.range(0));
+    size_t num_of_bytes = 0;
+    for ( auto _ : state )
+    {
+        YAML::Emitter out;
+        LegacyParser::copyYaml(document, out);
+        num_of_bytes += out.size();
+    }
+    state.SetBytesProcessed(num_of_bytes);
+}
+BENCHMARK(BM_documentCopyYaml)->Apply(documentSizes)->Unit(benchmark::kMicrosecond);
+
+#ifdef USE_GEOMETRY_COMMON
+
+using kelo::geometry_common::Box2D;
+using kelo::geometry_common::Box3D;
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::XYTheta;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::Circle;
+using kelo::geometry_common::TransformMatrix2D;
+using kelo::geometry_common::TransformMatrix3D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::Polyline2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::PointCloudProjectorConfig;
+
+template <typename T>
+static T geometrySample()
+{
+    return T();
+}
+
+template <>
+Polyline2D geometrySample<Polyline2D>()
+{
+    Polyline2D polyline;
+    for ( size_t i = 0; i < 8; i++ )
+    {
+        polyline.vertices.push_back(Point2D(0.125f * i, -0.25f * i));
+    }
+    return polyline;
+}
+
+template <>
+Polygon2D geometrySample<Polygon2D>()
+{
+    Polygon2D polygon;
+    for ( size_t i = 0; i < 8; i++ )
+    {
+        polygon.vertices.push_back(Point2D(0.125f * i, -0.25f * i));
+    }
+    return polygon;
+}
+
+/**
+ * @brief Decode a sequence of `size` values of `T` with its `YAML::convert`
+ */
+template <typename T>
+static void BM_documentGeometryDecode(benchmark::State& state)
+{
+    const YAML::Node document = YAML::Load(YAML::Dump(
+            YAML::Node(std::vector<T>(state.range(0), geometrySample<T>()))));
+    for ( auto _ : state )
+    {
+        std::vector<T> values;
+        if ( !Parser::read(document, values, false) )
+        {
+            state.SkipWithError("could not decode");
+            break;
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_documentGeometryEncode(benchmark::State& state)
+{
+    const std::vector<T> values(state.range(0), geometrySample<T>());
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(YAML::Node(values));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define GEOMETRY_BENCHMARKS(T) \
+    BENCHMARK_TEMPLATE(BM_documentGeometryDecode, T)->Apply(documentSizes); \
+    BENCHMARK_TEMPLATE(BM_documentGeometryEncode, T)->Apply(documentSizes)
+
+GEOMETRY_BENCHMARKS(Box2D);
+GEOMETRY_BENCHMARKS(Box3D);
+GEOMETRY_BENCHMARKS(Point2D);
+GEOMETRY_BENCHMARKS(Point3D);
+GEOMETRY_BENCHMARKS(XYTheta);
+GEOMETRY_BENCHMARKS(Pose2D);
+GEOMETRY_BENCHMARKS(Circle);
+GEOMETRY_BENCHMARKS(TransformMatrix2D);
+GEOMETRY_BENCHMARKS(TransformMatrix3D);
+GEOMETRY_BENCHMARKS(LineSegment2D);
+GEOMETRY_BENCHMARKS(Polyline2D);
+GEOMETRY_BENCHMARKS(Polygon2D);
+GEOMETRY_BENCHMARKS(PointCloudProjectorConfig);
+
+#endif // USE_GEOMETRY_COMMON
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/FieldSchema.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::FieldSchema;
+
+/**
+ * @brief Struct shaped like PointCloudProjectorConfig without the transform
+ */
+struct ProjectorLimits
+{
+    float angle_min, angle_max;
+    float passthrough_min_z, passthrough_max_z;
+    float radial_dist_min, radial_dist_max;
+    float angle_increment;
+};
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+template <>
+struct schema<ProjectorLimits>
+{
+    using T = ProjectorLimits;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("angle_min", &T::angle_min),
+            FieldSchema::field("angle_max", &T::angle_max),
+            FieldSchema::field("passthrough_min_z", &T::passthrough_min_z),
+            FieldSchema::field("passthrough_max_z", &T::passthrough_max_z),
+            FieldSchema::field("radial_dist_min", &T::radial_dist_min),
+            FieldSchema::field("radial_dist_max", &T::radial_dist_max),
+            FieldSchema::field("angle_increment", &T::angle_increment));
+};
+constexpr decltype(schema<ProjectorLimits>::fields) schema<ProjectorLimits>::fields;
+
+} // namespace yaml_common
+} // namespace kelo
+
+static const char* const limits_yaml =
+    "{angle_min: -1.5, angle_max: 1.5, passthrough_min_z: 0.05, passthrough_max_z: 2.0,"
+    " radial_dist_min: 0.1, radial_dist_max: 10.0, angle_increment: 0.01}";
+
+/**
+ * Hand-written decode as the geometry conversions used to be: a key lookup
+ * per field
+ */
+static void BM_decodePerFieldRead(benchmark::State& state)
+{
+    const YAML::Node node = YAML::Load(limits_yaml);
+    ProjectorLimits limits;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(
+                Parser::read<float>(node, "angle_min", limits.angle_min, nullptr) &&
+                Parser::read<float>(node, "angle_max", limits.angle_max, nullptr) &&
+                Parser::read<float>(node, "passthrough_min_z", limits.passthrough_min_z, nullptr) &&
+                Parser::read<float>(node, "passthrough_max_z", limits.passthrough_max_z, nullptr) &&
+                Parser::read<float>(node, "radial_dist_min", limits.radial_dist_min, nullptr) &&
+                Parser::read<float>(node, "radial_dist_max", limits.radial_dist_max, nullptr) &&
+                Parser::read<float>(node, "angle_increment", limits.angle_increment, nullptr));
+    }
+}
+BENCHMARK(BM_decodePerFieldRead);
+
+static void BM_decodeFieldSchema(benchmark::State& state)
+{
+    const YAML::Node node = YAML::Load(limits_yaml);
+    ProjectorLimits limits;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(FieldSchema::decode(node, limits, nullptr));
+    }
+}
+BENCHMARK(BM_decodeFieldSchema);
+
+static void BM_validateFieldSchema(benchmark::State& state)
+{
+    const YAML::Node node = YAML::Load(limits_yaml);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(FieldSchema::validate<ProjectorLimits>(node));
+    }
+}
+BENCHMARK(BM_validateFieldSchema);
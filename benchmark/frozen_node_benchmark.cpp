@@ -0,0 +1,109 @@
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::FrozenTree;
+
+static const size_t num_of_params = 256;
+
+/**
+ * @brief Planner config with scalar parameters and small vectors
+ */
+static const YAML::Node& plannerConfig()
+{
+    static const YAML::Node config = []()
+    {
+        YAML::Node node;
+        for ( size_t i = 0; i < num_of_params; i++ )
+        {
+            node["gain_" + std::to_string(i)] = 0.01 * i;
+            node["limits_" + std::to_string(i)] = std::vector<double>{-1.0, 1.0};
+        }
+        return YAML::Load(YAML::Dump(node));
+    }();
+    return config;
+}
+
+static const std::vector<std::string>& paramKeys()
+{
+    static const std::vector<std::string> keys = []()
+    {
+        std::vector<std::string> names;
+        for ( size_t i = 0; i < num_of_params; i += 7 )
+        {
+            names.push_back("gain_" + std::to_string(i));
+        }
+        return names;
+    }();
+    return keys;
+}
+
+/**
+ * @brief Shared YAML::Node with every read guarded by a mutex, as planners
+ * had to do before FrozenTree
+ */
+static void BM_mutexGuardedRead(benchmark::State& state)
+{
+    static std::mutex mutex;
+    const YAML::Node& config = plannerConfig();
+    const std::vector<std::string>& keys = paramKeys();
+    for ( auto _ : state )
+    {
+        double sum = 0.0;
+        for ( const std::string& key : keys )
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sum += Parser::get<double>(config, key, 0.0);
+        }
+        std::vector<double> limits;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Parser::read(config, "limits_42", limits, false);
+        }
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(limits.data());
+    }
+    state.SetItemsProcessed(state.iterations() * ( keys.size() + 1 ));
+}
+BENCHMARK(BM_mutexGuardedRead)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_frozenRead(benchmark::State& state)
+{
+    static const std::shared_ptr<const FrozenTree> config =
+        std::make_shared<const FrozenTree>(plannerConfig());
+    const std::vector<std::string>& keys = paramKeys();
+    for ( auto _ : state )
+    {
+        double sum = 0.0;
+        for ( const std::string& key : keys )
+        {
+            sum += Parser::get<double>(config->root(), key, 0.0);
+        }
+        std::vector<double> limits;
+        Parser::read(config->root(), "limits_42", limits, false);
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(limits.data());
+    }
+    state.SetItemsProcessed(state.iterations() * ( keys.size() + 1 ));
+}
+BENCHMARK(BM_frozenRead)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_freeze(benchmark::State& state)
+{
+    const YAML::Node& config = plannerConfig();
+    for ( auto _ : state )
+    {
+        FrozenTree tree(config);
+        benchmark::DoNotOptimize(tree.numOfNodes());
+    }
+}
+BENCHMARK(BM_freeze)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,79 @@
+#ifdef USE_GEOMETRY_COMMON
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Polygon2D.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Polygon2D;
+
+/**
+ * @brief Create a zone layer of `size` polygons with 8 vertices each
+ */
+static std::vector<Polygon2D> createZones(size_t size)
+{
+    std::vector<Polygon2D> zones(size);
+    for ( size_t i = 0; i < size; i++ )
+    {
+        for ( size_t j = 0; j < 8; j++ )
+        {
+            zones[i].vertices.push_back(Point2D(i + 0.125f * j, i - 0.25f * j));
+        }
+    }
+    return zones;
+}
+
+static void BM_emitThroughNode(benchmark::State& state)
+{
+    const std::vector<Polygon2D> zones = createZones(state.range(0));
+    size_t num_of_bytes = 0;
+    for ( auto _ : state )
+    {
+        YAML::Emitter out;
+        out << YAML::Node(zones);
+        num_of_bytes += out.size();
+    }
+    state.SetBytesProcessed(num_of_bytes);
+}
+BENCHMARK(BM_emitThroughNode)->RangeMultiplier(10)->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_emitDirect(benchmark::State& state)
+{
+    const std::vector<Polygon2D> zones = createZones(state.range(0));
+    size_t num_of_bytes = 0;
+    for ( auto _ : state )
+    {
+        YAML::Emitter out;
+        out << zones;
+        num_of_bytes += out.size();
+    }
+    state.SetBytesProcessed(num_of_bytes);
+}
+BENCHMARK(BM_emitDirect)->RangeMultiplier(10)->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_emitDirectFlow(benchmark::State& state)
+{
+    const std::vector<Polygon2D> zones = createZones(state.range(0));
+    size_t num_of_bytes = 0;
+    for ( auto _ : state )
+    {
+        YAML::Emitter out;
+        out.SetMapFormat(YAML::Flow);
+        out << zones;
+        num_of_bytes += out.size();
+    }
+    state.SetBytesProcessed(num_of_bytes);
+}
+BENCHMARK(BM_emitDirectFlow)->RangeMultiplier(10)->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+#endif // USE_GEOMETRY_COMMON
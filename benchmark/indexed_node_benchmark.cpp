@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/IndexedNode.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::IndexedNode;
+
+static YAML::Node createStationsYaml(size_t num_of_keys)
+{
+    YAML::Node node(YAML::NodeType::Map);
+    for ( size_t i = 0; i < num_of_keys; i++ )
+    {
+        node["station_" + std::to_string(i)] = static_cast<float>(i);
+    }
+    return node;
+}
+
+/**
+ * Read every key of a map of given width through the linear yaml-cpp lookup
+ */
+static void BM_readAllStations(benchmark::State& state)
+{
+    const size_t num_of_keys = state.range(0);
+    const YAML::Node node = createStationsYaml(num_of_keys);
+    std::vector<std::string> keys;
+    Parser::readAllKeys(node, keys);
+    float value;
+    for ( auto _ : state )
+    {
+        for ( const std::string& key : keys )
+        {
+            benchmark::DoNotOptimize(Parser::read(node, key, value, false));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_of_keys);
+}
+BENCHMARK(BM_readAllStations)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_readAllStationsIndexed(benchmark::State& state)
+{
+    const size_t num_of_keys = state.range(0);
+    const IndexedNode node(createStationsYaml(num_of_keys));
+    std::vector<std::string> keys;
+    Parser::readAllKeys(node, keys);
+    float value;
+    for ( auto _ : state )
+    {
+        for ( const std::string& key : keys )
+        {
+            benchmark::DoNotOptimize(Parser::read(node, key, value, false));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_of_keys);
+}
+BENCHMARK(BM_readAllStationsIndexed)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_buildIndex(benchmark::State& state)
+{
+    const YAML::Node node = createStationsYaml(state.range(0));
+    for ( auto _ : state )
+    {
+        IndexedNode indexed_node(node);
+        benchmark::DoNotOptimize(indexed_node.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_buildIndex)->RangeMultiplier(4)->Range(16, 4096);
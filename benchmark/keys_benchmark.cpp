@@ -0,0 +1,130 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+
+/* all heap allocations of the benchmark binary are counted, which is why it
+ * is built as yaml_common_keys_benchmarks of its own; the replacements are
+ * not inlined so that GCC does not pair their malloc/free with new/delete */
+static std::atomic<size_t> allocation_count{0};
+
+__attribute__((noinline)) void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(( size == 0 ) ? 1 : size);
+    if ( ptr == nullptr )
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * @brief Map with `size` keys long enough to defeat the small string
+ * optimisation, as in our station and map files
+ */
+static YAML::Node wideMap(size_t size)
+{
+    YAML::Node node;
+    for ( size_t i = 0; i < size; i++ )
+    {
+        node["station_with_a_long_name_" + std::to_string(i)] = i;
+    }
+    return YAML::Load(YAML::Dump(node));
+}
+
+/**
+ * @brief Run `enumerate` and report allocations per iteration and per key
+ */
+template <typename Enumerate>
+static void measureKeys(benchmark::State& state, Enumerate enumerate)
+{
+    const YAML::Node node = wideMap(state.range(0));
+    size_t allocations = 0;
+    for ( auto _ : state )
+    {
+        const size_t before = allocation_count.load(std::memory_order_relaxed);
+        enumerate(node);
+        allocations += allocation_count.load(std::memory_order_relaxed) - before;
+    }
+    state.counters["allocs_per_iter"] = benchmark::Counter(
+            static_cast<double>(allocations) / state.iterations());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_getAllKeysAs(benchmark::State& state)
+{
+    /* Parser::getAllKeys before it was built on Parser2::forEachKey */
+    measureKeys(state, [](const YAML::Node& node)
+    {
+        std::vector<std::string> keys;
+        for ( YAML::const_iterator it = node.begin(); it != node.end(); ++it )
+        {
+            keys.push_back(it->first.as<std::string>());
+        }
+        benchmark::DoNotOptimize(keys.data());
+    });
+}
+BENCHMARK(BM_getAllKeysAs)->Arg(16)->Arg(1024);
+
+static void BM_getAllKeys(benchmark::State& state)
+{
+    measureKeys(state, [](const YAML::Node& node)
+    {
+        std::vector<std::string> keys = kelo::yaml_common::Parser::getAllKeys(node);
+        benchmark::DoNotOptimize(keys.data());
+    });
+}
+BENCHMARK(BM_getAllKeys)->Arg(16)->Arg(1024);
+
+static void BM_readAllKeys(benchmark::State& state)
+{
+    measureKeys(state, [](const YAML::Node& node)
+    {
+        std::vector<std::string> keys;
+        benchmark::DoNotOptimize(Parser::readAllKeys(node, keys));
+    });
+}
+BENCHMARK(BM_readAllKeys)->Arg(16)->Arg(1024);
+
+static void BM_readAllKeyViews(benchmark::State& state)
+{
+    measureKeys(state, [](const YAML::Node& node)
+    {
+        std::vector<const std::string*> keys;
+        benchmark::DoNotOptimize(Parser::readAllKeys(node, keys));
+    });
+}
+BENCHMARK(BM_readAllKeyViews)->Arg(16)->Arg(1024);
+
+static void BM_forEachKey(benchmark::State& state)
+{
+    measureKeys(state, [](const YAML::Node& node)
+    {
+        size_t length = 0;
+        benchmark::DoNotOptimize(Parser::forEachKey(node,
+                [&length](const std::string& key) { length += key.size(); }));
+        benchmark::DoNotOptimize(length);
+    });
+}
+BENCHMARK(BM_forEachKey)->Arg(16)->Arg(1024);
@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::FileLoadMode;
+
+/**
+ * @brief Write a map file of about `size` bytes to `file_path` with zones
+ * similar to the ones of our map files and return its path
+ */
+static std::string createMapFile(const std::string& file_path, size_t size)
+{
+    std::ofstream file(file_path);
+    for ( size_t i = 0; static_cast<size_t>(file.tellp()) < size; i++ )
+    {
+        file << "zone_" << i << ":\n"
+             << "  type: restricted\n"
+             << "  max_vel: " << 0.1 * (i % 10) << "\n"
+             << "  polygon: [[" << i << ".5, 1.25], [" << i << ".5, 3.75], ["
+             << i + 1 << ".0, 3.75], [" << i + 1 << ".0, 1.25]]\n";
+    }
+    return file_path;
+}
+
+/**
+ * @brief Write a map file of about `size_mb` MB and return its path
+ */
+static std::string createMapFile(size_t size_mb)
+{
+    return createMapFile("/tmp/yaml_common_load_file_benchmark_"
+                         + std::to_string(size_mb) + "MB.yaml",
+                         size_mb * 1024 * 1024);
+}
+
+static void BM_loadFile(benchmark::State& state, FileLoadMode mode)
+{
+    const std::string file_path = createMapFile(state.range(0));
+    for ( auto _ : state )
+    {
+        YAML::Node node;
+        if ( !Parser::loadFile(file_path, node, mode) )
+        {
+            state.SkipWithError("could not load file");
+            break;
+        }
+        benchmark::DoNotOptimize(node);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 1024 * 1024);
+    std::remove(file_path.c_str());
+}
+BENCHMARK_CAPTURE(BM_loadFile, stream, FileLoadMode::STREAM)
+    ->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_loadFile, memory_map, FileLoadMode::MEMORY_MAP)
+    ->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Load 64 files of 32 kB each, as at the startup of our launch, with
+ * the given maximum number of threads
+ */
+static void BM_loadFiles(benchmark::State& state)
+{
+    std::vector<std::string> file_paths;
+    for ( size_t i = 0; i < 64; i++ )
+    {
+        file_paths.push_back(createMapFile("/tmp/yaml_common_load_files_benchmark_"
+                                           + std::to_string(i) + ".yaml", 32 * 1024));
+    }
+    for ( auto _ : state )
+    {
+        std::vector<YAML::Node> nodes;
+        std::vector<bool> is_loaded;
+        if ( !Parser::loadFiles(file_paths, nodes, is_loaded, state.range(0)) )
+        {
+            state.SkipWithError("could not load files");
+            break;
+        }
+        benchmark::DoNotOptimize(nodes);
+    }
+    for ( const std::string& file_path : file_paths )
+    {
+        std::remove(file_path.c_str());
+    }
+}
+BENCHMARK(BM_loadFiles)->RangeMultiplier(2)->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
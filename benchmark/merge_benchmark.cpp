@@ -0,0 +1,187 @@
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+
+/**
+ * Map with `num_of_keys` keys of which every fourth one is a nested map. The
+ * override layer touches every other key of the base layer and adds as many
+ * new keys.
+ */
+static YAML::Node createLayerYaml(size_t num_of_keys, size_t offset)
+{
+    YAML::Node node(YAML::NodeType::Map);
+    for ( size_t i = offset; i < offset + num_of_keys; i++ )
+    {
+        const std::string key = "param_" + std::to_string(i);
+        if ( i % 4 == 0 )
+        {
+            YAML::Node child;
+            child["value"] = static_cast<int>(i);
+            child["offset"] = static_cast<int>(offset);
+            node.force_insert(key, child);
+        }
+        else
+        {
+            node.force_insert(key, static_cast<int>(i));
+        }
+    }
+    return node;
+}
+
+/**
+ * mergeYAML as it was before keys were indexed: every lookup and insert is a
+ * linear scan of the map (kept here as reference for the comparison)
+ */
+static YAML::Node mergeYAMLQuadratic(const YAML::Node& base_node,
+                                     const YAML::Node& override_node)
+{
+    if ( !override_node.IsMap() )
+    {
+        return override_node.IsNull() ? base_node : override_node;
+    }
+    if ( !base_node.IsMap() )
+    {
+        return override_node;
+    }
+    if ( !base_node.size() )
+    {
+        return YAML::Node(override_node);
+    }
+    auto new_node = YAML::Node(YAML::NodeType::Map);
+    for ( auto node : base_node )
+    {
+        if ( node.first.IsScalar() )
+        {
+            const std::string& key = node.first.Scalar();
+            if ( override_node[key] )
+            {
+                new_node[node.first.Scalar()] = mergeYAMLQuadratic(
+                        node.second, override_node[key]);
+                continue;
+            }
+        }
+        new_node[node.first.Scalar()] = node.second;
+    }
+    for ( auto node : override_node )
+    {
+        if ( !node.first.IsScalar() || !new_node[node.first.Scalar()] )
+        {
+            new_node[node.first.Scalar()] = node.second;
+        }
+    }
+    return YAML::Node(new_node);
+}
+
+static void BM_mergeYAMLQuadratic(benchmark::State& state)
+{
+    const size_t num_of_keys = state.range(0);
+    const YAML::Node base_node = createLayerYaml(num_of_keys, 0);
+    const YAML::Node override_node = createLayerYaml(num_of_keys, num_of_keys / 2);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(mergeYAMLQuadratic(base_node, override_node));
+    }
+    state.SetItemsProcessed(state.iterations() * num_of_keys);
+}
+BENCHMARK(BM_mergeYAMLQuadratic)->RangeMultiplier(4)->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_mergeYAML(benchmark::State& state)
+{
+    const size_t num_of_keys = state.range(0);
+    const YAML::Node base_node = createLayerYaml(num_of_keys, 0);
+    const YAML::Node override_node = createLayerYaml(num_of_keys, num_of_keys / 2);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::mergeYAML(base_node, override_node));
+    }
+    state.SetItemsProcessed(state.iterations() * num_of_keys);
+}
+BENCHMARK(BM_mergeYAML)->RangeMultiplier(4)->Range(64, 4096)
+    ->Arg(16384)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static std::vector<YAML::Node> createLayers(size_t num_of_keys)
+{
+    std::vector<YAML::Node> layers;
+    for ( size_t i = 0; i < 5; i++ )
+    {
+        layers.push_back(createLayerYaml(num_of_keys, i * num_of_keys / 8));
+    }
+    return layers;
+}
+
+static void BM_mergeYAMLPairwise(benchmark::State& state)
+{
+    const size_t num_of_keys = state.range(0);
+    const std::vector<YAML::Node> layers = createLayers(num_of_keys);
+    for ( auto _ : state )
+    {
+        YAML::Node node = layers.front();
+        for ( size_t i = 1; i < layers.size(); i++ )
+        {
+            node.reset(Parser::mergeYAML(node, layers[i]));
+        }
+        benchmark::DoNotOptimize(node);
+    }
+    state.SetItemsProcessed(state.iterations() * num_of_keys * layers.size());
+}
+BENCHMARK(BM_mergeYAMLPairwise)->RangeMultiplier(4)->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_mergeLayers(benchmark::State& state)
+{
+    const size_t num_of_keys = state.range(0);
+    const std::vector<YAML::Node> layers = createLayers(num_of_keys);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::mergeLayers(layers));
+    }
+    state.SetItemsProcessed(state.iterations() * num_of_keys * layers.size());
+}
+BENCHMARK(BM_mergeLayers)->RangeMultiplier(4)->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Create a YAML map of 16 sections holding `num_of_keys` keys in total
+ */
+static YAML::Node createSectionedYaml(size_t num_of_keys)
+{
+    YAML::Node node(YAML::NodeType::Map);
+    for ( size_t i = 0; i < 16; i++ )
+    {
+        node.force_insert("section_" + std::to_string(i),
+                          createLayerYaml(num_of_keys / 16, 0));
+    }
+    return node;
+}
+
+static const char* const small_override_yaml =
+    "{section_3: {param_1: -1, param_4: {value: -4}}, section_9: {param_2: -2}}";
+
+static void BM_mergeYAMLSmallOverride(benchmark::State& state)
+{
+    const YAML::Node base_node = createSectionedYaml(state.range(0));
+    const YAML::Node override_node = YAML::Load(small_override_yaml);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::mergeYAML(base_node, override_node));
+    }
+}
+BENCHMARK(BM_mergeYAMLSmallOverride)->RangeMultiplier(8)->Range(1024, 65536)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_mergeYAMLInPlaceSmallOverride(benchmark::State& state)
+{
+    YAML::Node base_node = createSectionedYaml(state.range(0));
+    const YAML::Node override_node = YAML::Load(small_override_yaml);
+    for ( auto _ : state )
+    {
+        Parser::mergeYAMLInPlace(base_node, override_node);
+    }
+}
+BENCHMARK(BM_mergeYAMLInPlaceSmallOverride)->RangeMultiplier(8)->Range(1024, 65536)
+    ->Unit(benchmark::kMicrosecond);
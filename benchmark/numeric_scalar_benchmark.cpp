@@ -0,0 +1,80 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/NumericScalar.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::NumericScalar;
+
+/* scalars as they typically appear in our config and map files */
+static const std::vector<std::string> int_scalars{
+        "0", "7", "42", "-3", "1024", "65535", "0x1F", "-2147483648"};
+static const std::vector<std::string> float_scalars{
+        "0", "0.5", "-1.25", "3.14159", "100.0", "0.001", "-12.75", "1e-3",
+        "0.10000000000000001", "1.7976931348623157e308"};
+
+template <typename T>
+static const std::vector<std::string>& scalars()
+{
+    return ( std::is_integral<T>::value ) ? int_scalars : float_scalars;
+}
+
+template <typename T>
+static void BM_yamlCppConvert(benchmark::State& state)
+{
+    std::vector<YAML::Node> nodes;
+    for ( const std::string& scalar : scalars<T>() )
+    {
+        nodes.push_back(YAML::Node(scalar));
+    }
+    for ( auto _ : state )
+    {
+        for ( const YAML::Node& node : nodes )
+        {
+            T value;
+            benchmark::DoNotOptimize(YAML::convert<T>::decode(node, value));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK_TEMPLATE(BM_yamlCppConvert, int);
+BENCHMARK_TEMPLATE(BM_yamlCppConvert, float);
+BENCHMARK_TEMPLATE(BM_yamlCppConvert, double);
+
+template <typename T>
+static void BM_numericScalarParse(benchmark::State& state)
+{
+    for ( auto _ : state )
+    {
+        for ( const std::string& scalar : scalars<T>() )
+        {
+            T value;
+            benchmark::DoNotOptimize(NumericScalar::parse(scalar, value));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * scalars<T>().size());
+}
+BENCHMARK_TEMPLATE(BM_numericScalarParse, int);
+BENCHMARK_TEMPLATE(BM_numericScalarParse, float);
+BENCHMARK_TEMPLATE(BM_numericScalarParse, double);
+
+static void BM_readFloats(benchmark::State& state)
+{
+    const YAML::Node node = YAML::Load("{x: 1.5, y: -2.25, z: 0.125, roll: 0.0, "
+                                       "pitch: 0.7853981633974483, yaw: 3.14159}");
+    const std::vector<std::string> keys{"x", "y", "z", "roll", "pitch", "yaw"};
+    std::vector<float> values;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::readFloats(node, keys, values));
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_readFloats);
@@ -0,0 +1,60 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+
+/**
+ * @brief Create a flat sequence of `size` numbers like the cells of a costmap
+ * or the samples of a lookup table
+ */
+static YAML::Node createSequence(size_t size)
+{
+    YAML::Node sequence(YAML::NodeType::Sequence);
+    for ( size_t i = 0; i < size; i++ )
+    {
+        std::ostringstream scalar;
+        scalar << ( i % 1000 ) * 0.125 - 60.0;
+        sequence.push_back(scalar.str());
+    }
+    return sequence;
+}
+
+template <typename T>
+static void BM_asVector(benchmark::State& state)
+{
+    const YAML::Node sequence = createSequence(state.range(0));
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(sequence.as<std::vector<T>>());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_readVector(benchmark::State& state)
+{
+    const YAML::Node sequence = createSequence(state.range(0));
+    for ( auto _ : state )
+    {
+        std::vector<T> values;
+        Parser::read<std::vector<T>>(sequence, values);
+        benchmark::DoNotOptimize(values);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_asVector, float)->Arg(10000)->Arg(1000000)->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_readVector, float)->Arg(10000)->Arg(1000000)->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_asVector, double)->Arg(10000)->Arg(1000000)->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_readVector, double)->Arg(10000)->Arg(1000000)->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,105 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/ParameterRegistry.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::FrozenTree;
+using kelo::yaml_common::ParameterRegistry;
+
+static const size_t num_of_components = 32;
+static const size_t num_of_params = 16;
+
+/**
+ * @brief Config of `num_of_components` components; `value` is assigned to
+ * the first parameter of the first component
+ */
+static YAML::Node componentConfig(double value)
+{
+    YAML::Node node;
+    for ( size_t i = 0; i < num_of_components; i++ )
+    {
+        YAML::Node component;
+        for ( size_t j = 0; j < num_of_params; j++ )
+        {
+            component["param_" + std::to_string(j)] = 0.5 * j;
+        }
+        component["limits"] = std::vector<double>{-1.0, 1.0, -2.0, 2.0};
+        node["component_" + std::to_string(i)] = component;
+    }
+    node["component_0"]["param_0"] = value;
+    return YAML::Load(YAML::Dump(node));
+}
+
+static std::string paramPath(size_t component, size_t param)
+{
+    return "component_" + std::to_string(component) + "/param_" + std::to_string(param);
+}
+
+/**
+ * @brief Reload that changes one value, handled the way init code does by
+ * reading every parameter again
+ */
+static void BM_reloadReadAll(benchmark::State& state)
+{
+    const YAML::Node configs[2] = {componentConfig(1.0), componentConfig(2.0)};
+    std::vector<double> values(num_of_components * num_of_params);
+    std::vector<std::vector<double>> limits(num_of_components);
+    size_t i = 0;
+    for ( auto _ : state )
+    {
+        const YAML::Node& config = configs[i++ % 2];
+        for ( size_t c = 0; c < num_of_components; c++ )
+        {
+            const YAML::Node component = config["component_" + std::to_string(c)];
+            for ( size_t p = 0; p < num_of_params; p++ )
+            {
+                Parser::read(component, "param_" + std::to_string(p),
+                             values[c * num_of_params + p], false);
+            }
+            Parser::read(component, "limits", limits[c], false);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+}
+BENCHMARK(BM_reloadReadAll)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Same reload with ParameterRegistry, which only decodes the
+ * changed binding
+ */
+static void BM_reloadRegistry(benchmark::State& state)
+{
+    const std::shared_ptr<const FrozenTree> configs[2] = {
+        std::make_shared<const FrozenTree>(componentConfig(1.0)),
+        std::make_shared<const FrozenTree>(componentConfig(2.0))};
+    std::vector<double> values(num_of_components * num_of_params);
+    std::vector<std::vector<double>> limits(num_of_components);
+    ParameterRegistry registry;
+    for ( size_t c = 0; c < num_of_components; c++ )
+    {
+        for ( size_t p = 0; p < num_of_params; p++ )
+        {
+            registry.bind(paramPath(c, p), values[c * num_of_params + p], 0.0);
+        }
+        registry.bind("component_" + std::to_string(c) + "/limits", limits[c],
+                      std::vector<double>());
+    }
+    registry.update(configs[0], nullptr);
+
+    size_t i = 1;
+    for ( auto _ : state )
+    {
+        registry.update(configs[i++ % 2], nullptr);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.counters["bindings"] = registry.size();
+}
+BENCHMARK(BM_reloadRegistry)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,209 @@
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/Parser.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using LegacyParser = kelo::yaml_common::Parser;
+
+/**
+ * Cost of a failed probe through `node.as<T>()` guarded by try/catch, which is
+ * how Parser2::read used to detect a conversion failure
+ */
+static void BM_missAsWithCatch(benchmark::State& state)
+{
+    YAML::Node node = YAML::Load("{s: abc}");
+    const YAML::Node& value_node = node["s"];
+    for ( auto _ : state )
+    {
+        bool success = true;
+        try
+        {
+            benchmark::DoNotOptimize(value_node.as<int>());
+        }
+        catch ( YAML::Exception& )
+        {
+            success = false;
+        }
+        benchmark::DoNotOptimize(success);
+    }
+}
+BENCHMARK(BM_missAsWithCatch);
+
+static void BM_missIs(benchmark::State& state)
+{
+    YAML::Node node = YAML::Load("{s: abc}");
+    const YAML::Node& value_node = node["s"];
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::is<int>(value_node));
+    }
+}
+BENCHMARK(BM_missIs);
+
+static void BM_hitIs(benchmark::State& state)
+{
+    YAML::Node node = YAML::Load("{i: 5}");
+    const YAML::Node& value_node = node["i"];
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::is<int>(value_node));
+    }
+}
+BENCHMARK(BM_hitIs);
+
+static void BM_missHasWrongType(benchmark::State& state)
+{
+    YAML::Node node = YAML::Load("{a: 1, b: 2, s: abc}");
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::has<double>(node, "s"));
+    }
+}
+BENCHMARK(BM_missHasWrongType);
+
+static void BM_missSequenceElement(benchmark::State& state)
+{
+    YAML::Node node = YAML::Load("[1, 2, 3, 4, x]");
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::is<std::vector<int>>(node));
+    }
+}
+BENCHMARK(BM_missSequenceElement);
+
+static void BM_missKeyNoSink(benchmark::State& state)
+{
+    YAML::Node node = YAML::Load("{a: 1, b: 2, s: abc}");
+    int value = 0;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::read(node, "c", value, false));
+    }
+}
+BENCHMARK(BM_missKeyNoSink);
+
+static void BM_missKeyBufferedSink(benchmark::State& state)
+{
+    YAML::Node node = YAML::Load("{a: 1, b: 2, s: abc}");
+    kelo::yaml_common::BufferedErrorSink error_sink;
+    int value = 0;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::read(node, "c", value, &error_sink));
+        if ( error_sink.size() > 1000 )
+        {
+            error_sink.clear();
+        }
+    }
+}
+BENCHMARK(BM_missKeyBufferedSink);
+
+static YAML::Node createWideMapYaml(size_t num_of_keys)
+{
+    YAML::Node node(YAML::NodeType::Map);
+    for ( size_t i = 0; i < num_of_keys; i++ )
+    {
+        node["station_parameter_" + std::to_string(i)] = static_cast<int>(i);
+    }
+    return node;
+}
+
+/**
+ * Keyed read as `hasKey` + `node[key]` i.e. two yaml-cpp map scans
+ */
+static void BM_readKeyDoubleLookup(benchmark::State& state)
+{
+    const YAML::Node node = createWideMapYaml(state.range(0));
+    const std::string key = "station_parameter_" + std::to_string(state.range(0) - 1);
+    int value = 0;
+    for ( auto _ : state )
+    {
+        if ( node[key] )
+        {
+            benchmark::DoNotOptimize(Parser::read(node[key], value, false));
+        }
+    }
+}
+BENCHMARK(BM_readKeyDoubleLookup)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_readKey(benchmark::State& state)
+{
+    const YAML::Node node = createWideMapYaml(state.range(0));
+    const std::string key = "station_parameter_" + std::to_string(state.range(0) - 1);
+    int value = 0;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::read(node, key, value, false));
+    }
+}
+BENCHMARK(BM_readKey)->Arg(10)->Arg(100)->Arg(1000);
+
+/**
+ * Single map scan without decoding, as reference for the keyed reads above
+ * and below: with one scan per read they only add the cost of decoding
+ */
+static void BM_findKey(benchmark::State& state)
+{
+    const YAML::Node node = createWideMapYaml(state.range(0));
+    const std::string key = "station_parameter_" + std::to_string(state.range(0) - 1);
+    YAML::Node child;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::find(node, key, child, nullptr));
+    }
+}
+BENCHMARK(BM_findKey)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_legacyHasPose(benchmark::State& state)
+{
+    YAML::Node node = createWideMapYaml(state.range(0));
+    const std::string key = "station_parameter_" + std::to_string(state.range(0));
+    node[key] = std::vector<double>{1.0, 2.0, 0.5};
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(LegacyParser::hasPose(node, key));
+    }
+}
+BENCHMARK(BM_legacyHasPose)->Arg(10)->Arg(100)->Arg(1000);
+
+#ifdef USE_GEOMETRY_COMMON
+static YAML::Node createPolygonYaml(size_t num_of_vertices)
+{
+    YAML::Node node(YAML::NodeType::Sequence);
+    for ( size_t i = 0; i < num_of_vertices; i++ )
+    {
+        YAML::Node vertex;
+        vertex["x"] = static_cast<float>(i);
+        vertex["y"] = static_cast<float>(i) * 0.5f;
+        node.push_back(vertex);
+    }
+    return node;
+}
+
+static void BM_isPolygon(benchmark::State& state)
+{
+    YAML::Node node = createPolygonYaml(state.range(0));
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::is<kelo::geometry_common::Polygon2D>(node));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_isPolygon)->Arg(100)->Arg(10000);
+
+static void BM_readPolygon(benchmark::State& state)
+{
+    YAML::Node node = createPolygonYaml(state.range(0));
+    kelo::geometry_common::Polygon2D polygon;
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(Parser::read(node, polygon, false));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_readPolygon)->Arg(100)->Arg(10000);
+#endif // USE_GEOMETRY_COMMON
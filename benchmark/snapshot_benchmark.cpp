@@ -0,0 +1,58 @@
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Snapshot.h>
+
+using kelo::yaml_common::Snapshot;
+
+/**
+ * @brief Create YAML text of about `size` bytes with zones similar to the ones
+ * of our map files
+ */
+static std::string createMapText(size_t size)
+{
+    std::ostringstream text;
+    for ( size_t i = 0; static_cast<size_t>(text.tellp()) < size; i++ )
+    {
+        text << "zone_" << i << ":\n"
+             << "  type: restricted\n"
+             << "  max_vel: " << 0.1 * (i % 10) << "\n"
+             << "  polygon: [[" << i << ".5, 1.25], [" << i << ".5, 3.75], ["
+             << i + 1 << ".0, 3.75], [" << i + 1 << ".0, 1.25]]\n";
+    }
+    return text.str();
+}
+
+static void BM_parseText(benchmark::State& state)
+{
+    const std::string text = createMapText(state.range(0) * 1024);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(YAML::Load(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_parseText)->RangeMultiplier(8)->Range(8, 4096)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_loadSnapshot(benchmark::State& state)
+{
+    const std::string text = createMapText(state.range(0) * 1024);
+    std::string data;
+    Snapshot::serialize(YAML::Load(text), data);
+    for ( auto _ : state )
+    {
+        YAML::Node node;
+        Snapshot::deserialize(data.data(), data.size(), node);
+        benchmark::DoNotOptimize(node);
+    }
+    // throughput relative to the text, to compare with BM_parseText
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.counters["snapshot_size"] = data.size();
+}
+BENCHMARK(BM_loadSnapshot)->RangeMultiplier(8)->Range(8, 4096)
+    ->Unit(benchmark::kMillisecond);
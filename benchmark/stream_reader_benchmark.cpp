@@ -0,0 +1,80 @@
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+#include <yaml_common/StreamReader.h>
+
+#ifdef USE_GEOMETRY_COMMON
+#include <geometry_common/Point2D.h>
+
+using kelo::geometry_common::Point2D;
+#endif // USE_GEOMETRY_COMMON
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::StreamReader;
+
+using PointMap = std::map<std::string, double>;
+
+/**
+ * @brief Create a document with a sequence of `size` points under
+ * `map/points`, preceded by some unrelated keys
+ */
+static std::string createPointsText(size_t size)
+{
+    std::ostringstream text;
+    text << "name: benchmark\nmap:\n  resolution: 0.05\n  points:\n";
+    for ( size_t i = 0; i < size; i++ )
+    {
+        text << "    - {x: " << i << ".25, y: " << i << ".75}\n";
+    }
+    text << "  frame: map\n";
+    return text.str();
+}
+
+template <typename T>
+static void BM_loadAndRead(benchmark::State& state)
+{
+    const std::string text = createPointsText(state.range(0));
+    for ( auto _ : state )
+    {
+        const YAML::Node node = YAML::Load(text);
+        std::vector<T> points;
+        Parser::read<std::vector<T>>(node["map"], "points", points);
+        benchmark::DoNotOptimize(points);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+template <typename T>
+static void BM_streamRead(benchmark::State& state)
+{
+    const std::string text = createPointsText(state.range(0));
+    for ( auto _ : state )
+    {
+        std::istringstream input(text);
+        std::vector<T> points;
+        StreamReader::readSequence<T>(input, {"map", "points"}, points);
+        benchmark::DoNotOptimize(points);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_TEMPLATE(BM_loadAndRead, PointMap)->RangeMultiplier(10)->Range(100, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_streamRead, PointMap)->RangeMultiplier(10)->Range(100, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+#ifdef USE_GEOMETRY_COMMON
+BENCHMARK_TEMPLATE(BM_loadAndRead, Point2D)->RangeMultiplier(10)->Range(100, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_streamRead, Point2D)->RangeMultiplier(10)->Range(100, 100000)
+    ->Unit(benchmark::kMillisecond);
+#endif // USE_GEOMETRY_COMMON
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_ASYNC_ERROR_SINK_H
+#define KELO_YAML_COMMON_ASYNC_ERROR_SINK_H
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <yaml_common/ErrorSink.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Format and write errors to an output stream on a background thread
+ * so that the reporting thread never waits on I/O. Pending errors are written
+ * before the sink is destroyed.
+ */
+class AsyncErrorSink : public ErrorSink
+{
+    public:
+
+        AsyncErrorSink(std::ostream& out = std::cout);
+
+        virtual ~AsyncErrorSink();
+
+        void report(const Error& error) override;
+
+        /**
+         * @brief Block until all errors reported so far are written
+         */
+        void flush();
+
+    private:
+
+        struct Record
+        {
+            ErrorCode code;
+            std::string detail;
+        };
+
+        void run();
+
+        std::ostream& out_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<Record> queue_;
+        size_t num_of_pending_{0};
+        bool stop_{false};
+        std::thread worker_;
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_ASYNC_ERROR_SINK_H
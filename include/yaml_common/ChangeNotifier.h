@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_CHANGE_NOTIFIER_H
+#define KELO_YAML_COMMON_CHANGE_NOTIFIER_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Dispatch the differences between consecutive versions of a config
+ * to the consumers subscribed to the affected key paths, so that a reload
+ * only re-initialises what changed.
+ *
+ * A subscription to a path prefix receives a change if the change is at or
+ * below the prefix (e.g. "controller/max_vel" for "controller") or above it
+ * (e.g. the whole "controller" map replaced for "controller/max_vel").
+ * Prefixes are matched segment by segment, so "controller" does not match
+ * "controller2"; the empty prefix matches every change.
+ *
+ * example:
+ * \code
+ *     ChangeNotifier notifier;
+ *     notifier.subscribe("controller", [&](const std::vector<PathChange>& changes)
+ *                        { controller.configure(notifier.current()->root()); });
+ *     watcher.setCallback([&](const std::shared_ptr<const FrozenTree>& tree)
+ *                         { notifier.update(tree); });
+ * \endcode
+ *
+ * All functions are thread-safe. Callbacks are called on the thread calling
+ * `update` or `notify`, without holding a lock, in the order of subscription.
+ */
+class ChangeNotifier
+{
+    public:
+
+        /**
+         * @brief Function receiving the changes relevant to a subscription
+         */
+        using Callback = std::function<void(const std::vector<PathChange>& changes)>;
+
+        /**
+         * @brief Subscribe to changes affecting `prefix`
+         *
+         * @param prefix key path joined with '/' as in PathChange
+         * @param callback function called with the relevant changes of each
+         * update that has any
+         * @return size_t id of the subscription for `unsubscribe`
+         */
+        size_t subscribe(const std::string& prefix, const Callback& callback);
+
+        /**
+         * @brief Remove a subscription
+         *
+         * @return bool false if there is no subscription with `id`
+         */
+        bool unsubscribe(size_t id);
+
+        /**
+         * @brief Diff `tree` against the tree of the previous update with
+         * Parser2::diffYAML and notify the subscribers. The first update
+         * reports the root as ADDED.
+         *
+         * @param tree new version of the config
+         */
+        void update(const std::shared_ptr<const FrozenTree>& tree);
+
+        /**
+         * @brief Call every subscriber affected by `changes` once with the
+         * changes relevant to it
+         */
+        void notify(const std::vector<PathChange>& changes) const;
+
+        /**
+         * @brief Tree of the most recent update (`nullptr` before the first)
+         */
+        std::shared_ptr<const FrozenTree> current() const;
+
+        /**
+         * @brief Whether a change at `path` is relevant to a subscription to
+         * `prefix`, i.e. one is an ancestor of the other or they are equal
+         */
+        static bool isAffected(const std::string& prefix, const std::string& path);
+
+    private:
+
+        struct Subscription
+        {
+            size_t id;
+            std::string prefix;
+            Callback callback;
+        };
+
+        mutable std::mutex mutex_;
+        std::vector<Subscription> subscriptions_;
+        size_t next_id_{0};
+        std::shared_ptr<const FrozenTree> tree_;
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_CHANGE_NOTIFIER_H
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_CHECK_H
+#define KELO_YAML_COMMON_CHECK_H
+
+#include <yaml-cpp/yaml.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Validation-only counterpart of `YAML::convert<T>`. `validate` must
+ * return true exactly when `YAML::convert<T>::decode` would succeed, but only
+ * inspects the shape and scalars of the node without constructing `T`.
+ *
+ * Specialise it next to the `YAML::convert<T>` specialisation of a type.
+ * Without a specialisation, `T` is decoded into a temporary (see Parser2.h).
+ *
+ * example:
+ * \code
+ *     template <>
+ *     struct check<YourType>
+ *     {
+ *         static bool validate(const YAML::Node& node);
+ *     };
+ * \endcode
+ *
+ * @tparam T type whose YAML representation needs to be validated
+ */
+template <typename T>
+struct check;
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_CHECK_H
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_CONFIG_WATCHER_H
+#define KELO_YAML_COMMON_CONFIG_WATCHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Watch .yaml files and publish their content as a FrozenTree every
+ * time they change, so that parameters can be changed without restarting
+ * the process.
+ *
+ * Changes are detected on a background thread (with inotify on Linux, by
+ * polling the modification time and size elsewhere), the files are parsed
+ * and merged there, and the new tree replaces the current one with an
+ * atomic pointer swap. `current()` never waits for parsing or for a reload
+ * in progress; a tree is freed when the last `std::shared_ptr` to it is
+ * released, so readers may keep using an old tree as long as they need.
+ * Files that fail to load keep the current tree in place and the error is
+ * reported to the error sink.
+ *
+ * example:
+ * \code
+ *     ConfigWatcher watcher({"/opt/robot/defaults.yaml", "/opt/robot/site.yaml"});
+ *     watcher.start();
+ *     // on any thread
+ *     std::shared_ptr<const FrozenTree> config = watcher.current();
+ *     float speed = Parser2::get<float>(config->root(), "max_speed", 1.0f);
+ * \endcode
+ *
+ * Directories of the files are watched, so files replaced by renaming
+ * (like most editors and deployment tools do) are picked up as well.
+ */
+class ConfigWatcher
+{
+    public:
+
+        /**
+         * @brief Function called on the reloading thread with each newly
+         * published tree
+         */
+        using Callback = std::function<void(const std::shared_ptr<const FrozenTree>&)>;
+
+        /**
+         * @brief Watcher of a single file
+         *
+         * @param abs_file_path absolute path of .yaml file
+         * @param error_sink receiver of load errors (called from the
+         * background thread; `nullptr` discards them)
+         */
+        explicit ConfigWatcher(
+                const std::string& abs_file_path,
+                ErrorSink* error_sink = Parser2::defaultErrorSink());
+
+        /**
+         * @brief Watcher of several files merged with Parser2::mergeLayers
+         *
+         * @param abs_file_paths absolute paths of .yaml files ordered from
+         * lowest to highest precedence
+         * @param error_sink receiver of load errors
+         */
+        explicit ConfigWatcher(
+                const std::vector<std::string>& abs_file_paths,
+                ErrorSink* error_sink = Parser2::defaultErrorSink());
+
+        /**
+         * @brief Stops watching; trees obtained from `current()` stay valid
+         */
+        ~ConfigWatcher();
+
+        ConfigWatcher(const ConfigWatcher&) = delete;
+        ConfigWatcher& operator = (const ConfigWatcher&) = delete;
+
+        /**
+         * @brief Set the function called after each reload. Must be called
+         * before `start`.
+         */
+        void setCallback(const Callback& callback);
+
+        /**
+         * @brief Load the files and start watching them
+         *
+         * @return bool false if the files could not be loaded (nothing is
+         * watched then) or the watcher is already running
+         */
+        bool start();
+
+        /**
+         * @brief Stop watching the files and join the background thread
+         */
+        void stop();
+
+        /**
+         * @brief Load the files on the calling thread and publish them if
+         * they could be loaded
+         *
+         * @return bool success in loading the files
+         */
+        bool reload();
+
+        /**
+         * @brief Most recently published tree, `nullptr` before the first
+         * successful load. May be called from any thread.
+         *
+         * @note Wait-free: the call is a fixed sequence of atomic operations
+         * that is never retried, whatever reloads happen meanwhile, so its
+         * latency is bounded on real-time threads. The reload waits for
+         * readers instead.
+         */
+        std::shared_ptr<const FrozenTree> current() const;
+
+        /**
+         * @brief Number of trees published so far
+         */
+        uint64_t version() const
+        {
+            return version_.load();
+        }
+
+        /**
+         * @brief Time for which changes are collected after the first one
+         * before the files are reloaded, so that writes in quick succession
+         * cause a single reload
+         */
+        static const int DEBOUNCE_MS = 20;
+
+    private:
+
+        class FileWatch;
+
+        /**
+         * @brief Published tree, replaced as a whole on every reload
+         */
+        struct Version
+        {
+            std::shared_ptr<const FrozenTree> tree;
+        };
+
+        void publish(const std::shared_ptr<const FrozenTree>& tree);
+
+        void watch();
+
+        std::vector<std::string> abs_file_paths_;
+        ErrorSink* error_sink_;
+        Callback callback_;
+
+        /* serialises reloads, never taken by readers */
+        std::mutex reload_mutex_;
+        std::atomic<uint64_t> version_{0};
+
+        /* readers register in the slot of the epoch they read while copying
+         * the tree out of `published_`; a writer swaps the pointer and
+         * drains both slots in turn (moving to the next epoch before each)
+         * before it frees the old Version */
+        std::atomic<Version*> published_;
+        std::atomic<uint64_t> epoch_{0};
+        mutable std::atomic<size_t> num_of_readers_[2];
+
+        std::unique_ptr<FileWatch> file_watch_;
+        std::thread thread_;
+        std::atomic<bool> is_running_{false};
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_CONFIG_WATCHER_H
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_ERROR_CODE_H
+#define KELO_YAML_COMMON_ERROR_CODE_H
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Reason of a failure reported by Parser2
+ */
+enum class ErrorCode
+{
+    EMPTY_KEY, ///< given key is an empty string
+    NOT_A_MAP, ///< given node is not a map
+    MISSING_KEY, ///< map does not contain the key (detail: key)
+    BAD_VALUE, ///< node could not be converted to the requested type
+    BAD_VALUE_FOR_KEY, ///< value of a key could not be converted (detail: key)
+    NON_SCALAR_KEY, ///< map contains a non-scalar key
+    BAD_FILE, ///< file could not be opened (detail: file path)
+    PARSE_ERROR, ///< file is not valid YAML (detail: parser message)
+    OTHER ///< free-form message (detail: message)
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_ERROR_CODE_H
@@ -0,0 +1,219 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_ERROR_SINK_H
+#define KELO_YAML_COMMON_ERROR_SINK_H
+
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <yaml_common/ErrorCode.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief A single error reported by Parser2. It only refers to its detail
+ * string, so it is cheap to create; the human readable message is formatted
+ * on demand by `message()`.
+ *
+ * The detail has to be an lvalue string that outlives the error; temporaries
+ * (e.g. string literals or concatenations) are rejected at compile time.
+ *
+ * @note `detail` is only guaranteed to be alive during `ErrorSink::report`.
+ * Sinks that keep errors around need to copy it.
+ */
+class Error
+{
+    public:
+
+        Error(ErrorCode code, const std::string& detail):
+            code_(code),
+            detail_(&detail) {}
+
+        Error(ErrorCode code, std::string&& detail) = delete;
+        Error(ErrorCode code, const char* detail) = delete;
+
+        ErrorCode code() const
+        {
+            return code_;
+        }
+
+        const std::string& detail() const
+        {
+            return *detail_;
+        }
+
+        /**
+         * @brief Format a human readable message for this error
+         *
+         * @return std::string formatted message
+         */
+        std::string message() const;
+
+    private:
+
+        ErrorCode code_;
+        const std::string* detail_;
+
+};
+
+/**
+ * @brief Interface for receivers of errors reported by Parser2.
+ *
+ * Parser2 functions accepting an `ErrorSink*` report every failure to it.
+ * Passing `nullptr` means nobody is listening and no message is formatted.
+ */
+class ErrorSink
+{
+    public:
+
+        virtual ~ErrorSink() {}
+
+        /**
+         * @brief Receive an error. Implementations must be thread-safe when
+         * the sink is shared between threads.
+         *
+         * @param error error that occurred
+         */
+        virtual void report(const Error& error) = 0;
+
+};
+
+/**
+ * @brief Print errors to an output stream (`std::cout` by default) in red
+ * colored font without flushing after each of them
+ */
+class ConsoleErrorSink : public ErrorSink
+{
+    public:
+
+        ConsoleErrorSink(std::ostream& out = std::cout):
+            out_(out) {}
+
+        void report(const Error& error) override;
+
+    private:
+
+        std::mutex mutex_;
+        std::ostream& out_;
+
+};
+
+/**
+ * @brief Forward errors to a user provided function
+ */
+class CallbackErrorSink : public ErrorSink
+{
+    public:
+
+        using Callback = std::function<void(const Error&)>;
+
+        CallbackErrorSink(const Callback& callback):
+            callback_(callback) {}
+
+        void report(const Error& error) override;
+
+    private:
+
+        Callback callback_;
+
+};
+
+/**
+ * @brief Store errors in memory so that they can be inspected or printed in
+ * one go later
+ */
+class BufferedErrorSink : public ErrorSink
+{
+    public:
+
+        void report(const Error& error) override;
+
+        /**
+         * @brief Number of errors stored so far
+         */
+        size_t size() const;
+
+        /**
+         * @brief Error codes of the stored errors in the order they occurred
+         */
+        std::vector<ErrorCode> codes() const;
+
+        /**
+         * @brief Formatted messages of the stored errors in the order they
+         * occurred
+         */
+        std::vector<std::string> messages() const;
+
+        /**
+         * @brief Write all stored errors to `out` and clear the buffer
+         *
+         * @param out stream to write the messages to
+         */
+        void flush(std::ostream& out = std::cout);
+
+        /**
+         * @brief Discard all stored errors
+         */
+        void clear();
+
+    private:
+
+        struct Record
+        {
+            ErrorCode code;
+            std::string detail;
+        };
+
+        mutable std::mutex mutex_;
+        std::vector<Record> records_;
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_ERROR_SINK_H
@@ -0,0 +1,449 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_FIELD_SCHEMA_H
+#define KELO_YAML_COMMON_FIELD_SCHEMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief A member of `T` stored under the key `name` of a YAML map
+ */
+template <typename T, typename M>
+struct Field
+{
+    const char* name;
+    uint64_t hash; ///< FieldSchema::hash of `name`
+    M T::* member;
+    bool is_optional; ///< missing or invalid values are ignored when decoding
+};
+
+namespace detail
+{
+
+struct FieldListEnd
+{
+    static constexpr size_t size = 0;
+};
+
+template <typename F, typename Next>
+struct FieldList
+{
+    static constexpr size_t size = 1 + Next::size;
+
+    F field;
+    Next next;
+};
+
+template <typename... Fs>
+struct FieldListOf;
+
+template <>
+struct FieldListOf<>
+{
+    using type = FieldListEnd;
+};
+
+template <typename F, typename... Fs>
+struct FieldListOf<F, Fs...>
+{
+    using type = FieldList<F, typename FieldListOf<Fs...>::type>;
+};
+
+} // namespace detail
+
+/**
+ * @brief List of fields of `T`, to be specialised with a static constexpr
+ * member `fields` created by FieldSchema::fields.
+ *
+ * example:
+ * \code
+ *     template <>
+ *     struct schema<YourType>
+ *     {
+ *         static constexpr auto fields = FieldSchema::fields(
+ *                 FieldSchema::field("x", &YourType::x),
+ *                 FieldSchema::field("name", &YourType::name),
+ *                 FieldSchema::optionalField("offset", &YourType::offset));
+ *     };
+ *
+ *     // in exactly one .cpp file
+ *     constexpr decltype(schema<YourType>::fields) schema<YourType>::fields;
+ * \endcode
+ */
+template <typename T>
+struct schema;
+
+/**
+ * @brief Conversions of structs generated from their `schema`.
+ *
+ * The hashes of the keys are computed at compile time. Decoding scans the
+ * map once, matching each key against the hashes of all fields, instead of
+ * looking up every field with a separate scan. Of duplicate keys, the first
+ * one is used (as with Parser2::read). Errors are the same as those of
+ * reading each field with Parser2::read in the order of the schema.
+ *
+ * example:
+ * \code
+ *     namespace YAML
+ *     {
+ *     template <>
+ *     struct convert<YourType>
+ *     {
+ *         static Node encode(const YourType& value)
+ *         {
+ *             return kelo::yaml_common::FieldSchema::encode(value);
+ *         }
+ *
+ *         static bool decode(const Node& node, YourType& value)
+ *         {
+ *             return kelo::yaml_common::FieldSchema::decode(node, value);
+ *         }
+ *     };
+ *     } // namespace YAML
+ * \endcode
+ */
+class FieldSchema
+{
+    public:
+
+        /**
+         * @brief 64 bit FNV-1a hash of a key, usable in constant expressions
+         */
+        static constexpr uint64_t hash(const char* key,
+                                       uint64_t value = fnv_offset_basis)
+        {
+            return ( *key == '\0' )
+                   ? value
+                   : FieldSchema::hash(key + 1, ( value ^ static_cast<unsigned char>(*key) ) *
+                                                fnv_prime);
+        }
+
+        /**
+         * @brief Same as `hash(key.c_str())` for keys read at runtime
+         */
+        static uint64_t hash(const std::string& key)
+        {
+            uint64_t value = fnv_offset_basis;
+            for ( const char c : key )
+            {
+                value = ( value ^ static_cast<unsigned char>(c) ) * fnv_prime;
+            }
+            return value;
+        }
+
+        /**
+         * @brief Field that must be present for decoding to succeed
+         */
+        template <typename T, typename M>
+        static constexpr Field<T, M> field(const char* name, M T::* member)
+        {
+            return Field<T, M>{name, FieldSchema::hash(name), member, false};
+        }
+
+        /**
+         * @brief Field that keeps its value when it is missing or invalid
+         */
+        template <typename T, typename M>
+        static constexpr Field<T, M> optionalField(const char* name, M T::* member)
+        {
+            return Field<T, M>{name, FieldSchema::hash(name), member, true};
+        }
+
+        /**
+         * @brief Create the list of fields of a `schema`
+         */
+        static constexpr detail::FieldListEnd fields()
+        {
+            return detail::FieldListEnd{};
+        }
+
+        template <typename F, typename... Fs>
+        static constexpr typename detail::FieldListOf<F, Fs...>::type fields(
+                F field, Fs... other_fields)
+        {
+            return typename detail::FieldListOf<F, Fs...>::type{
+                    field, FieldSchema::fields(other_fields...)};
+        }
+
+        /**
+         * @brief Encode `value` as a map of all its fields, in schema order
+         */
+        template <typename T>
+        static YAML::Node encode(const T& value)
+        {
+            YAML::Node node(YAML::NodeType::Map);
+            FieldSchema::encodeFields(schema<T>::fields, value, node);
+            return node;
+        }
+
+        /**
+         * @brief Write `value` as a map of all its fields to `out`, without
+         * building a YAML::Node. The output is the same as emitting the node
+         * of `encode`; YAML::Flow written before gives the flow form.
+         */
+        template <typename T>
+        static void emit(YAML::Emitter& out, const T& value)
+        {
+            out << YAML::BeginMap;
+            FieldSchema::emitFields(schema<T>::fields, value, out);
+            out << YAML::EndMap;
+        }
+
+        /**
+         * @brief Decode the fields of `value` from the map `node`. Errors are
+         * reported to Parser2::activeErrorSink.
+         *
+         * @return bool false if a field that is not optional is missing or
+         * invalid
+         */
+        template <typename T>
+        static bool decode(const YAML::Node& node, T& value)
+        {
+            return FieldSchema::decode(node, value, Parser2::activeErrorSink());
+        }
+
+        /**
+         * @brief Decode the fields of `value` from the map `node` and report
+         * failures to `error_sink` (nothing is reported when it is `nullptr`)
+         */
+        template <typename T>
+        static bool decode(const YAML::Node& node, T& value, ErrorSink* error_sink)
+        {
+            using List = typename std::decay<decltype(schema<T>::fields)>::type;
+            FieldStatus status[List::size] = {};
+            FieldSchema::scan(node, schema<T>::fields, status, DecodeField<T>{value});
+            return FieldSchema::reportInvalid(schema<T>::fields, node, value,
+                                              status, error_sink);
+        }
+
+        /**
+         * @brief Check that `node` is a map from which all fields that are not
+         * optional can be decoded
+         */
+        template <typename T>
+        static bool validate(const YAML::Node& node)
+        {
+            using List = typename std::decay<decltype(schema<T>::fields)>::type;
+            FieldStatus status[List::size] = {};
+            FieldSchema::scan(node, schema<T>::fields, status, ValidateField<T>());
+            return FieldSchema::isValid(schema<T>::fields, status);
+        }
+
+    private:
+
+        static constexpr uint64_t fnv_offset_basis = 14695981039346656037ULL;
+        static constexpr uint64_t fnv_prime = 1099511628211ULL;
+
+        enum class FieldStatus
+        {
+            MISSING,
+            VALID,
+            INVALID
+        };
+
+        template <typename T>
+        struct DecodeField
+        {
+            T& value;
+
+            template <typename M>
+            bool operator () (const YAML::Node& node, M T::* member) const
+            {
+                return ( Parser2::decode(node, value.*member) == DecodeStatus::SUCCESS );
+            }
+        };
+
+        template <typename T>
+        struct ValidateField
+        {
+            template <typename M>
+            bool operator () (const YAML::Node& node, M T::* /*member*/) const
+            {
+                return Parser2::is<M>(node);
+            }
+        };
+
+        template <typename T>
+        static void encodeFields(const detail::FieldListEnd& /*list*/,
+                                 const T& /*value*/, YAML::Node& /*node*/)
+        {
+        }
+
+        template <typename T, typename F, typename Next>
+        static void encodeFields(const detail::FieldList<F, Next>& list,
+                                 const T& value, YAML::Node& node)
+        {
+            node.force_insert(list.field.name, value.*(list.field.member));
+            FieldSchema::encodeFields(list.next, value, node);
+        }
+
+        template <typename T>
+        static void emitFields(const detail::FieldListEnd& /*list*/,
+                               const T& /*value*/, YAML::Emitter& /*out*/)
+        {
+        }
+
+        template <typename T, typename F, typename Next>
+        static void emitFields(const detail::FieldList<F, Next>& list,
+                               const T& value, YAML::Emitter& out)
+        {
+            out << YAML::Key << list.field.name
+                << YAML::Value << value.*(list.field.member);
+            FieldSchema::emitFields(list.next, value, out);
+        }
+
+        /**
+         * @brief Apply `op` to the value of each key of the map `node` that
+         * names a field, recording the outcome in `status`
+         */
+        template <typename List, typename Op>
+        static void scan(const YAML::Node& node, const List& list,
+                         FieldStatus* status, const Op& op)
+        {
+            if ( !node.IsMap() )
+            {
+                return;
+            }
+            size_t num_of_matches = 0;
+            for ( const auto& entry : node )
+            {
+                if ( !entry.first.IsScalar() )
+                {
+                    continue;
+                }
+                const std::string& key = entry.first.Scalar();
+                if ( FieldSchema::match(list, FieldSchema::hash(key), key,
+                                        entry.second, status, op) &&
+                     ++num_of_matches == List::size )
+                {
+                    break;
+                }
+            }
+        }
+
+        template <typename Op>
+        static bool match(const detail::FieldListEnd& /*list*/, uint64_t /*hash*/,
+                          const std::string& /*key*/, const YAML::Node& /*node*/,
+                          FieldStatus* /*status*/, const Op& /*op*/)
+        {
+            return false;
+        }
+
+        template <typename F, typename Next, typename Op>
+        static bool match(const detail::FieldList<F, Next>& list, uint64_t hash,
+                          const std::string& key, const YAML::Node& node,
+                          FieldStatus* status, const Op& op)
+        {
+            if ( list.field.hash == hash && key == list.field.name )
+            {
+                /* later duplicates of a key are ignored */
+                if ( *status != FieldStatus::MISSING )
+                {
+                    return false;
+                }
+                *status = ( op(node, list.field.member) ) ? FieldStatus::VALID
+                                                          : FieldStatus::INVALID;
+                return true;
+            }
+            return FieldSchema::match(list.next, hash, key, node, status + 1, op);
+        }
+
+        template <typename T>
+        static bool reportInvalid(const detail::FieldListEnd& /*list*/,
+                                  const YAML::Node& /*node*/, T& /*value*/,
+                                  const FieldStatus* /*status*/,
+                                  ErrorSink* /*error_sink*/)
+        {
+            return true;
+        }
+
+        /**
+         * @brief Fail on the first field that is not optional and was not
+         * decoded. It is read again with Parser2::read to report the same
+         * errors as a read of each field would.
+         */
+        template <typename T, typename F, typename Next>
+        static bool reportInvalid(const detail::FieldList<F, Next>& list,
+                                  const YAML::Node& node, T& value,
+                                  const FieldStatus* status, ErrorSink* error_sink)
+        {
+            if ( *status != FieldStatus::VALID && !list.field.is_optional &&
+                 ( error_sink == nullptr ||
+                   !Parser2::read(node, list.field.name, value.*(list.field.member),
+                                  error_sink) ) )
+            {
+                return false;
+            }
+            return FieldSchema::reportInvalid(list.next, node, value,
+                                              status + 1, error_sink);
+        }
+
+        static bool isValid(const detail::FieldListEnd& /*list*/,
+                            const FieldStatus* /*status*/)
+        {
+            return true;
+        }
+
+        template <typename F, typename Next>
+        static bool isValid(const detail::FieldList<F, Next>& list,
+                            const FieldStatus* status)
+        {
+            return ( ( *status == FieldStatus::VALID || list.field.is_optional ) &&
+                     FieldSchema::isValid(list.next, status + 1) );
+        }
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_FIELD_SCHEMA_H
@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_FILE_CACHE_H
+#define KELO_YAML_COMMON_FILE_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+class FrozenTree;
+
+/**
+ * @brief Cache of parsed YAML files used by Parser2::loadFile once it is
+ * installed with Parser2::setFileCache. Entries are keyed on the canonical
+ * path of a file together with its modification time and size, so a file is
+ * parsed again as soon as it changes on disk. All functions are thread-safe.
+ *
+ * example:
+ * \code
+ *     static FileCache file_cache;
+ *     Parser2::setFileCache(&file_cache);
+ *     std::shared_ptr<const FrozenTree> config;
+ *     Parser2::loadFile("/opt/robot/description.yaml", config); // parsed
+ *     Parser2::loadFile("/opt/robot/description.yaml", config); // cache hit
+ * \endcode
+ *
+ * @note Files are cached as FrozenTree, since yaml-cpp nodes must not be used
+ * from several threads at once, not even for reading. A hit of the
+ * FrozenTree overload of `loadFile` only hands out a pointer to the cached
+ * tree. The YAML::Node overloads of `loadFile` return a mutable copy, which
+ * saves parsing on a hit but still builds the whole node tree.
+ */
+class FileCache
+{
+    public:
+
+        /**
+         * @brief Identity of a file on disk at a point in time
+         */
+        struct Key
+        {
+            std::string canonical_path;
+            int64_t mtime_ns{0};
+            uint64_t size{0};
+
+            /**
+             * @brief Whether the file could be resolved; invalid keys are
+             * never found or stored
+             */
+            bool isValid() const
+            {
+                return !canonical_path.empty();
+            }
+
+            bool operator == (const Key& other) const
+            {
+                return canonical_path == other.canonical_path &&
+                       mtime_ns == other.mtime_ns &&
+                       size == other.size;
+            }
+        };
+
+        /**
+         * @brief Resolve `file_path` to its canonical path and read its
+         * modification time and size
+         *
+         * @param file_path path of a file
+         * @return Key key of the file (invalid if the file does not exist)
+         */
+        static Key makeKey(const std::string& file_path);
+
+        /**
+         * @brief Look up the tree parsed from the file identified by `key`
+         *
+         * @param key key of the file as returned by `makeKey`
+         * @return std::shared_ptr<const FrozenTree> cached tree on a hit,
+         * `nullptr` otherwise; counts a hit or a miss
+         */
+        std::shared_ptr<const FrozenTree> find(const Key& key);
+
+        /**
+         * @brief Store the tree parsed from the file identified by `key`,
+         * replacing any older version of the same file
+         */
+        void insert(const Key& key, const std::shared_ptr<const FrozenTree>& tree);
+
+        /**
+         * @brief Drop the cached tree of `file_path`
+         *
+         * @return bool true if an entry was dropped
+         */
+        bool invalidate(const std::string& file_path);
+
+        /**
+         * @brief Drop all cached trees
+         */
+        void clear();
+
+        /**
+         * @brief Number of cached files
+         */
+        size_t size() const;
+
+        /**
+         * @brief Number of lookups that returned a cached tree
+         */
+        size_t numOfHits() const
+        {
+            return num_of_hits_.load();
+        }
+
+        /**
+         * @brief Number of lookups that required the file to be parsed
+         */
+        size_t numOfMisses() const
+        {
+            return num_of_misses_.load();
+        }
+
+    private:
+
+        struct Entry
+        {
+            int64_t mtime_ns;
+            uint64_t size;
+            std::shared_ptr<const FrozenTree> tree;
+        };
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+        std::atomic<size_t> num_of_hits_{0};
+        std::atomic<size_t> num_of_misses_{0};
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_FILE_CACHE_H
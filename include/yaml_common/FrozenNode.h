@@ -0,0 +1,481 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_FROZEN_NODE_H
+#define KELO_YAML_COMMON_FROZEN_NODE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+class FrozenTree;
+
+/**
+ * @brief Read-only view of a node of a FrozenTree. It is two words large and
+ * cheap to copy; it stays valid as long as its tree is alive.
+ *
+ * All member functions are const and never modify the tree, so any number
+ * of threads may read through views of the same tree at the same time. It is
+ * served by the `Parser2` functions `find`, `hasKey`, `read`, `decode`, `is`,
+ * `has`, `get`, `forEachKey` and `readAllKeys`.
+ */
+class FrozenNode
+{
+    public:
+
+        /**
+         * @brief Undefined node, like the value of a missing key
+         */
+        FrozenNode():
+            tree_(nullptr),
+            index_(0)
+        {
+        }
+
+        YAML::NodeType::value type() const;
+
+        bool isDefined() const
+        {
+            return ( type() != YAML::NodeType::Undefined );
+        }
+
+        bool isNull() const
+        {
+            return ( type() == YAML::NodeType::Null );
+        }
+
+        bool isScalar() const
+        {
+            return ( type() == YAML::NodeType::Scalar );
+        }
+
+        bool isSequence() const
+        {
+            return ( type() == YAML::NodeType::Sequence );
+        }
+
+        bool isMap() const
+        {
+            return ( type() == YAML::NodeType::Map );
+        }
+
+        /**
+         * @brief Number of elements of a sequence or entries of a map, 0 for
+         * other nodes
+         */
+        size_t size() const;
+
+        /**
+         * @brief Content of a scalar (empty for other nodes)
+         */
+        const std::string& scalar() const;
+
+        /**
+         * @brief Tag of the node as given by `YAML::Node::Tag()`
+         */
+        const std::string& tag() const;
+
+        /**
+         * @brief Element `index` of a sequence; undefined if out of range or
+         * not a sequence
+         */
+        FrozenNode operator [] (size_t index) const;
+
+        /**
+         * @brief Key of entry `entry` of a map; undefined if out of range or
+         * not a map
+         */
+        FrozenNode key(size_t entry) const;
+
+        /**
+         * @brief Value of entry `entry` of a map; undefined if out of range
+         * or not a map
+         */
+        FrozenNode value(size_t entry) const;
+
+        /**
+         * @brief Value of the scalar key `key` of a map (the first one for
+         * duplicate keys, like `YAML::Node::operator[]`); undefined if the
+         * key is missing or the node is not a map. Wide maps are searched in
+         * a sorted index, small ones with a linear scan.
+         */
+        FrozenNode find(const std::string& key) const;
+
+        /**
+         * @brief Hash of the subtree over types, tags, scalars and the order
+         * of entries, computed when the tree is frozen. Equal subtrees of
+         * different trees have equal hashes.
+         */
+        uint64_t hash() const;
+
+        /**
+         * @brief Whether both views refer to the same node of the same tree
+         */
+        bool is(const FrozenNode& other) const
+        {
+            return ( tree_ == other.tree_ && index_ == other.index_ );
+        }
+
+        /**
+         * @brief Copy of the subtree as a new, independent YAML::Node
+         */
+        YAML::Node thaw() const;
+
+    private:
+
+        friend class FrozenTree;
+
+        static const std::string& emptyString();
+
+        FrozenNode(const FrozenTree* tree, uint32_t index):
+            tree_(tree),
+            index_(index)
+        {
+        }
+
+        const FrozenTree* tree_;
+        uint32_t index_;
+
+};
+
+/**
+ * @brief Immutable copy of a YAML::Node tree in contiguous arrays, safe to
+ * read from any number of threads without locking.
+ *
+ * yaml-cpp nodes must not be accessed concurrently, not even through const
+ * functions: looking up a missing key creates a node in the shared memory of
+ * the tree. A FrozenTree is built once from a loaded node and afterwards
+ * only read, so threads can share it (e.g. as
+ * `std::shared_ptr<const FrozenTree>`) instead of copying the config or
+ * guarding each read with a mutex.
+ *
+ * example:
+ * \code
+ *     YAML::Node node;
+ *     Parser2::loadFile(path, node);
+ *     const auto config = std::make_shared<const FrozenTree>(node);
+ *     // on any thread
+ *     float speed = Parser2::get<float>(config->root(), "max_speed", 1.0f);
+ * \endcode
+ *
+ * Node types, scalars, tags, styles and the order of map entries are kept,
+ * source positions are not.
+ *
+ * Scalars, strings and sequences of them are read directly from the frozen
+ * data; other types are decoded from a thawed copy of their subtree (see
+ * FrozenNode::thaw) which is private to the reading thread.
+ */
+class FrozenTree
+{
+    public:
+
+        /**
+         * @brief Copy `node` and all nodes below it. Nodes shared through
+         * aliases are copied once per occurrence.
+         *
+         * @param node YAML node to freeze
+         */
+        explicit FrozenTree(const YAML::Node& node);
+
+        FrozenTree(const FrozenTree&) = delete;
+        FrozenTree& operator = (const FrozenTree&) = delete;
+
+        /**
+         * @brief View of the frozen copy of the node given to the constructor
+         */
+        FrozenNode root() const
+        {
+            return FrozenNode(this, 0);
+        }
+
+        /**
+         * @brief Total number of nodes (including map keys) in the tree
+         */
+        size_t numOfNodes() const
+        {
+            return elements_.size();
+        }
+
+    private:
+
+        friend class FrozenNode;
+
+        /* maps with more entries get a sorted index for `find` */
+        static const uint32_t LINEAR_FIND_MAX_SIZE = 8;
+
+        struct Element
+        {
+            YAML::NodeType::value type;
+            YAML::EmitterStyle::value style;
+            /* index of the first child; children are contiguous, maps
+             * store key and value of each entry next to each other */
+            uint32_t first;
+            /* number of elements of a sequence or entries of a map */
+            uint32_t size;
+            /* indices into `strings_` */
+            uint32_t scalar;
+            uint32_t tag;
+            /* range of `sorted_entries_` indexing a wide map */
+            uint32_t sorted_begin;
+            uint32_t sorted_end;
+            uint64_t hash;
+        };
+
+        uint32_t addString(const std::string& str);
+
+        void freeze(const YAML::Node& node, uint32_t index);
+
+        void index(uint32_t index);
+
+        std::vector<Element> elements_;
+        /* strings_[0] is the empty string */
+        std::vector<std::string> strings_;
+        /* entries of wide maps with scalar keys, stably sorted by key */
+        std::vector<uint32_t> sorted_entries_;
+
+};
+
+inline YAML::NodeType::value FrozenNode::type() const
+{
+    return ( tree_ == nullptr ) ? YAML::NodeType::Undefined
+                                : tree_->elements_[index_].type;
+}
+
+inline const std::string& FrozenNode::scalar() const
+{
+    return ( tree_ == nullptr ) ? FrozenNode::emptyString()
+                                : tree_->strings_[tree_->elements_[index_].scalar];
+}
+
+/* Parser2 FrozenNode overloads that need the complete FrozenNode */
+
+template <typename T>
+DecodeStatus Parser2::decode(
+        const FrozenNode& node,
+        T& value,
+        ErrorSink* error_sink)
+{
+    if ( !node.isDefined() )
+    {
+        return DecodeStatus::INVALID_NODE;
+    }
+    return detail::FrozenDecoder<T>::decode(node, value, error_sink);
+}
+
+template <typename T>
+bool Parser2::is(
+        const FrozenNode& node)
+{
+    return ( node.isDefined() && detail::FrozenDecoder<T>::validate(node) );
+}
+
+template <typename T>
+bool Parser2::has(
+        const FrozenNode& node,
+        const std::string& key)
+{
+    FrozenNode child;
+    return ( Parser2::find(node, key, child, nullptr) &&
+             Parser2::is<T>(child) );
+}
+
+template <typename Visitor>
+bool Parser2::forEachKey(
+        const FrozenNode& node,
+        Visitor&& visit,
+        ErrorSink* error_sink)
+{
+    if ( !node.isMap() )
+    {
+        Parser2::report(error_sink, ErrorCode::NOT_A_MAP);
+        return false;
+    }
+
+    for ( size_t i = 0; i < node.size(); i++ )
+    {
+        const FrozenNode key = node.key(i);
+        if ( !key.isScalar() )
+        {
+            Parser2::report(error_sink, ErrorCode::NON_SCALAR_KEY);
+            return false;
+        }
+        visit(key.scalar());
+    }
+    return true;
+}
+
+template <typename T>
+bool Parser2::readKey(
+        const FrozenNode& node,
+        const std::string& key,
+        T& value,
+        ErrorSink* error_sink)
+{
+    FrozenNode child;
+    if ( !Parser2::find(node, key, child, error_sink) )
+    {
+        return false;
+    }
+    if ( !Parser2::read(child, value, error_sink) )
+    {
+        Parser2::report(error_sink, ErrorCode::BAD_VALUE_FOR_KEY, key);
+        return false;
+    }
+    return true;
+}
+
+namespace detail
+{
+
+/* types without a direct decoder are decoded from a copy private to the
+ * calling thread */
+template <typename T, typename Enable>
+struct FrozenDecoder
+{
+    static DecodeStatus decode(const FrozenNode& node, T& value,
+                               ErrorSink* error_sink)
+    {
+        return Parser2::decode(node.thaw(), value, error_sink);
+    }
+
+    static bool validate(const FrozenNode& node)
+    {
+        return Parser2::is<T>(node.thaw());
+    }
+};
+
+template <typename T>
+struct FrozenDecoder<T, typename std::enable_if<NumericScalar::is_supported<T>::value>::type>
+{
+    static DecodeStatus decode(const FrozenNode& node, T& value, ErrorSink*)
+    {
+        return ( node.isScalar() && NumericScalar::parse(node.scalar(), value) )
+               ? DecodeStatus::SUCCESS : DecodeStatus::BAD_CONVERSION;
+    }
+
+    static bool validate(const FrozenNode& node)
+    {
+        T value;
+        return ( decode(node, value, nullptr) == DecodeStatus::SUCCESS );
+    }
+};
+
+template <>
+struct FrozenDecoder<std::string>
+{
+    static DecodeStatus decode(const FrozenNode& node, std::string& value,
+                               ErrorSink*)
+    {
+        if ( node.isNull() )
+        {
+            value = "null";
+            return DecodeStatus::SUCCESS;
+        }
+        if ( !node.isScalar() )
+        {
+            return DecodeStatus::BAD_CONVERSION;
+        }
+        value = node.scalar();
+        return DecodeStatus::SUCCESS;
+    }
+
+    static bool validate(const FrozenNode& node)
+    {
+        return ( node.isNull() || node.isScalar() );
+    }
+};
+
+template <typename T, typename A>
+struct FrozenDecoder<std::vector<T, A>>
+{
+    static DecodeStatus decode(const FrozenNode& node, std::vector<T, A>& value,
+                               ErrorSink* error_sink)
+    {
+        if ( !node.isSequence() )
+        {
+            return DecodeStatus::BAD_CONVERSION;
+        }
+        std::vector<T, A> elements;
+        elements.reserve(node.size());
+        for ( size_t i = 0; i < node.size(); i++ )
+        {
+            T element_value;
+            if ( FrozenDecoder<T>::decode(node[i], element_value, error_sink) !=
+                 DecodeStatus::SUCCESS )
+            {
+                return DecodeStatus::BAD_CONVERSION;
+            }
+            elements.push_back(std::move(element_value));
+        }
+        value = std::move(elements);
+        return DecodeStatus::SUCCESS;
+    }
+
+    static bool validate(const FrozenNode& node)
+    {
+        if ( !node.isSequence() )
+        {
+            return false;
+        }
+        for ( size_t i = 0; i < node.size(); i++ )
+        {
+            if ( !FrozenDecoder<T>::validate(node[i]) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace detail
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_FROZEN_NODE_H
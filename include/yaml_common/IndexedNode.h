@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_INDEXED_NODE_H
+#define KELO_YAML_COMMON_INDEXED_NODE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Wrapper around a YAML map node with a hash index over its scalar
+ * keys. yaml-cpp looks up keys with a linear scan, so use it for wide maps
+ * that are queried many times. It is served by the `Parser2` functions
+ * `find`, `hasKey`, `read`, `has`, `get` and `readAllKeys`.
+ *
+ * example:
+ * \code
+ *     IndexedNode stations(node["stations"]);
+ *     float speed = Parser2::get<float>(stations, "station_42", 0.0f);
+ * \endcode
+ *
+ * The wrapper refers to the same data as the wrapped node, so changed values
+ * of existing keys are seen immediately. Adding or removing keys is detected
+ * from the size of the map and the index is rebuilt on the next access. Call
+ * `refresh()` after changes that keep the size of the map identical (e.g.
+ * replacing one key by another).
+ *
+ * @note Like `YAML::Node`, it must not be accessed from multiple threads at
+ * the same time since the index may be rebuilt lazily.
+ */
+class IndexedNode
+{
+    public:
+
+        /**
+         * @brief Build the index over `node`. A node that is not a map is
+         * wrapped with an empty index and behaves like it in all Parser2
+         * functions.
+         *
+         * @param node YAML map node to be indexed
+         */
+        explicit IndexedNode(const YAML::Node& node);
+
+        /**
+         * @brief Wrapped node
+         */
+        const YAML::Node& node() const
+        {
+            return node_;
+        }
+
+        /**
+         * @brief Number of entries in the map
+         */
+        size_t size() const;
+
+        /**
+         * @brief Rebuild the index from the current content of the node
+         */
+        void refresh() const;
+
+        /**
+         * @brief Look up `key` in the index and make `child` refer to its
+         * value (see Parser2::find)
+         *
+         * @return true when the map contains `key`
+         */
+        bool lookup(const std::string& key, YAML::Node& child) const;
+
+        /**
+         * @brief Keys of the map in their original order
+         *
+         * @param keys vector to which the keys are appended
+         * @return false when the map contains a non-scalar key
+         */
+        bool keys(std::vector<std::string>& keys) const;
+
+    private:
+
+        void refreshIfStale() const;
+
+        YAML::Node node_;
+        mutable std::unordered_map<std::string, YAML::Node> index_;
+        /* pointers to keys of `index_` in map order (stable across rehash) */
+        mutable std::vector<const std::string*> ordered_keys_;
+        mutable size_t indexed_size_{0};
+        mutable bool has_non_scalar_key_{false};
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_INDEXED_NODE_H
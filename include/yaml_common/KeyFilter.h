@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_KEY_FILTER_H
+#define KELO_YAML_COMMON_KEY_FILTER_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Set of map keys and key paths whose subtrees are to be left out when
+ * walking a YAML tree, e.g. by Parser::copyYaml.
+ *
+ *   - keys added with `addKey` are skipped at any depth
+ *   - paths added with `addPath` are skipped only where the full path from
+ *     the root matches; path segments are separated by '/' and a "*" segment
+ *     matches any single map key or sequence index, e.g. "robots/0/mesh"
+ *     skips the mesh of the first robot only
+ *
+ * Matching is incremental: a walk keeps a `Position` per depth and calls
+ * `skip` once per key, so no path strings are built and a skipped subtree is
+ * never visited.
+ */
+class KeyFilter
+{
+    public:
+        /**
+         * @brief Set of path pattern prefixes matched by the path to a node
+         */
+        using Position = std::vector<size_t>;
+
+        KeyFilter();
+
+        /**
+         * @brief Skip `key` wherever it appears in a map
+         *
+         * @param key map key to be skipped
+         * @return KeyFilter& this filter
+         */
+        KeyFilter& addKey(const std::string& key);
+
+        /**
+         * @brief Skip the subtree at `pattern`
+         *
+         * @param pattern '/' separated path from the root, "*" segments match
+         * any key or sequence index
+         * @return KeyFilter& this filter
+         */
+        KeyFilter& addPath(const std::string& pattern);
+
+        /**
+         * @brief Skip the subtree at the path given as list of `segments`,
+         * for keys which themselves contain '/'
+         */
+        KeyFilter& addPath(const std::vector<std::string>& segments);
+
+        /**
+         * @brief Skip the subtree at the path given as list of `segments`,
+         * matched literally against map keys only: a "*" segment only
+         * matches the key "*" and a "0" segment never matches a sequence
+         * index
+         */
+        KeyFilter& addLiteralPath(const std::vector<std::string>& segments);
+
+        /**
+         * @return bool true if nothing is skipped
+         */
+        bool empty() const;
+
+        /**
+         * @return Position position of the root node of a tree
+         */
+        Position root() const;
+
+        /**
+         * @brief Check if a map entry is skipped
+         *
+         * @param position position of the map
+         * @param key key of the entry
+         * @param next set to the position of the entry's value if it is not
+         * skipped
+         * @return bool true if the entry is skipped
+         */
+        bool skip(const Position& position, const std::string& key,
+                  Position& next) const;
+
+        /**
+         * @brief Check if a sequence element is skipped; see above
+         */
+        bool skip(const Position& position, size_t index, Position& next) const;
+
+    private:
+        struct PatternNode
+        {
+            /* segments matching map keys and sequence indices */
+            std::unordered_map<std::string, size_t> children;
+            /* literal segments matching map keys only */
+            std::unordered_map<std::string, size_t> key_children;
+            size_t wildcard;
+            bool is_end;
+        };
+
+        /* trie of path patterns, nodes_[0] is the root */
+        std::vector<PatternNode> nodes_;
+        std::unordered_set<std::string> keys_;
+
+        size_t addSegment(size_t parent, const std::string& segment,
+                          bool is_literal);
+
+        KeyFilter& addSegments(const std::vector<std::string>& segments,
+                               bool is_literal);
+
+        bool stepPattern(const Position& position, const std::string* key,
+                         bool is_index, Position& next) const;
+
+        bool advance(size_t child, Position& next) const;
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_KEY_FILTER_H
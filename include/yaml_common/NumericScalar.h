@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_NUMERIC_SCALAR_H
+#define KELO_YAML_COMMON_NUMERIC_SCALAR_H
+
+#include <string>
+#include <type_traits>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Type of a plain YAML scalar as decided by NumericScalar::classify
+ */
+enum class ScalarType
+{
+    INT,
+    DOUBLE,
+    BOOL,
+    STRING
+};
+
+/**
+ * @brief Locale independent conversion of YAML scalars to bool and numbers.
+ *
+ * Accepts exactly what `YAML::convert<T>::decode` accepts and produces
+ * identical values, without the `std::stringstream` it constructs for each
+ * conversion:
+ *   - bool: y/n, yes/no, true/false and on/off in lower case, upper case or
+ *     capitalised
+ *   - integers: optional sign, decimal digits, hexadecimal with "0x"/"0X"
+ *     prefix or octal with "0" prefix; out of range values and negative
+ *     values of unsigned types are rejected
+ *   - floating point: optional sign, digits with optional decimal point and
+ *     exponent; ".inf", "-.inf", ".nan" (and their capitalised forms);
+ *     values overflowing to infinity are rejected
+ *
+ * Trailing whitespace is allowed, leading whitespace is not. Contrary to
+ * yaml-cpp, the result does not depend on the global locale.
+ */
+class NumericScalar
+{
+    public:
+
+        /**
+         * @brief Whether `parse` is provided for `T`. `char` is excluded
+         * since yaml-cpp reads it as a single character.
+         */
+        template <typename T>
+        struct is_supported;
+
+        /**
+         * @brief Convert `str` to `value`
+         *
+         * @param str content of a YAML scalar
+         * @param value variable to which the converted value is assigned; only
+         * modified on success
+         * @return bool false if `str` is not a valid representation of a value
+         * of the given type
+         */
+        static bool parse(const std::string& str, bool& value);
+        static bool parse(const std::string& str, signed char& value);
+        static bool parse(const std::string& str, unsigned char& value);
+        static bool parse(const std::string& str, short& value);
+        static bool parse(const std::string& str, unsigned short& value);
+        static bool parse(const std::string& str, int& value);
+        static bool parse(const std::string& str, unsigned int& value);
+        static bool parse(const std::string& str, long& value);
+        static bool parse(const std::string& str, unsigned long& value);
+        static bool parse(const std::string& str, long long& value);
+        static bool parse(const std::string& str, unsigned long long& value);
+        static bool parse(const std::string& str, float& value);
+        static bool parse(const std::string& str, double& value);
+
+        /**
+         * @brief Result of `classify`; only the value of `type` is set
+         */
+        struct Classification
+        {
+            ScalarType type;
+            int int_value;
+            double double_value;
+            bool bool_value;
+        };
+
+        /**
+         * @brief Find the first of int, double and bool that `str` converts
+         * to, otherwise STRING. Only the conversions that can apply to the
+         * first character of `str` are attempted, each parsing `str` once.
+         *
+         * @param str content of a YAML scalar
+         * @return Classification type of `str` and its converted value
+         */
+        static Classification classify(const std::string& str);
+
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+template <typename T>
+struct NumericScalar::is_supported : std::integral_constant<bool,
+    std::is_same<T, bool>::value ||
+    std::is_same<T, signed char>::value ||
+    std::is_same<T, unsigned char>::value ||
+    std::is_same<T, short>::value ||
+    std::is_same<T, unsigned short>::value ||
+    std::is_same<T, int>::value ||
+    std::is_same<T, unsigned int>::value ||
+    std::is_same<T, long>::value ||
+    std::is_same<T, unsigned long>::value ||
+    std::is_same<T, long long>::value ||
+    std::is_same<T, unsigned long long>::value ||
+    std::is_same<T, float>::value ||
+    std::is_same<T, double>::value> {};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_NUMERIC_SCALAR_H
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_PARAMETER_REGISTRY_H
+#define KELO_YAML_COMMON_PARAMETER_REGISTRY_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+namespace detail
+{
+
+/**
+ * @brief Keep `T` from being deduced from a parameter (e.g. a lambda passed
+ * as std::function)
+ */
+template <typename T>
+struct NonDeduced
+{
+    using type = T;
+};
+
+} // namespace detail
+
+/**
+ * @brief Decoding statistics of a binding of ParameterRegistry
+ */
+struct BindingStats
+{
+    std::string path;
+    size_t num_of_decodes; ///< decodes since the binding was added
+    std::chrono::nanoseconds last_decode_time;
+    std::chrono::nanoseconds total_decode_time;
+};
+
+/**
+ * @brief Bindings of config parameters to variables, registered once and
+ * updated with only the parameters that changed on every reload.
+ *
+ * Each binding decodes the value at its key path with Parser2::decode, so
+ * all types with a `YAML::convert` specialisation can be bound. A path that
+ * is missing assigns the default value; a value that cannot be decoded is
+ * reported once as BAD_VALUE_FOR_KEY with its path and leaves the variable
+ * unchanged.
+ *
+ * example:
+ * \code
+ *     ParameterRegistry registry;
+ *     registry.bind("controller/max_vel", max_vel_, 1.0f);
+ *     registry.bind<std::vector<double>>("controller/gains",
+ *             [this](const std::vector<double>& gains) { pid_.setGains(gains); },
+ *             {1.0, 0.0, 0.0});
+ *     watcher.setCallback([&](const std::shared_ptr<const FrozenTree>& tree)
+ *                         { registry.update(tree); });
+ * \endcode
+ *
+ * The registry is not thread-safe: `bind`, `update` and the bound variables
+ * need to be used from one thread or synchronised by the caller.
+ */
+class ParameterRegistry
+{
+    public:
+
+        /**
+         * @brief Bind `variable` to the value at `path`
+         *
+         * @param path key path joined with '/' (sequence elements by index)
+         * @param variable variable assigned on every update of the value; it
+         * has to outlive the binding
+         * @param default_value value assigned when `path` is missing
+         * @return size_t id of the binding for `unbind`
+         */
+        template <typename T>
+        size_t bind(
+                const std::string& path,
+                T& variable,
+                const T& default_value)
+        {
+            T* variable_ptr = &variable;
+            return ParameterRegistry::bind<T>(
+                    path, [variable_ptr](const T& value) { *variable_ptr = value; },
+                    default_value);
+        }
+
+        /**
+         * @brief Bind the value at `path` to a setter
+         *
+         * @param path key path joined with '/' (sequence elements by index)
+         * @param setter function called with every update of the value
+         * @param default_value value passed to `setter` when `path` is
+         * missing
+         * @return size_t id of the binding for `unbind`
+         */
+        template <typename T>
+        size_t bind(
+                const std::string& path,
+                const typename detail::NonDeduced<std::function<void(const T&)>>::type& setter,
+                const T& default_value)
+        {
+            return addBinding(path, [setter, default_value, path](
+                        const FrozenNode& node, ErrorSink* error_sink)
+            {
+                if ( !node.isDefined() )
+                {
+                    setter(default_value);
+                    return true;
+                }
+                T value(default_value);
+                if ( Parser2::decode(node, value, error_sink) != DecodeStatus::SUCCESS )
+                {
+                    if ( error_sink != nullptr )
+                    {
+                        error_sink->report(Error(ErrorCode::BAD_VALUE_FOR_KEY, path));
+                    }
+                    return false;
+                }
+                setter(value);
+                return true;
+            });
+        }
+
+        /**
+         * @brief Remove a binding
+         *
+         * @return bool false if there is no binding with `id`
+         */
+        bool unbind(size_t id);
+
+        /**
+         * @brief Decode the bindings whose path changed since the previous
+         * update (all of them on the first update) and those added since
+         *
+         * @param tree new version of the config
+         * @param error_sink receiver of decoding errors
+         * @return bool false if a value could not be decoded
+         */
+        bool update(
+                const std::shared_ptr<const FrozenTree>& tree,
+                ErrorSink* error_sink = Parser2::defaultErrorSink());
+
+        /**
+         * @brief Same as above for a config that is not frozen yet
+         */
+        bool update(
+                const YAML::Node& config,
+                ErrorSink* error_sink = Parser2::defaultErrorSink());
+
+        /**
+         * @brief Decoding statistics of all bindings in the order they were
+         * added, e.g. to find expensive bindings
+         */
+        std::vector<BindingStats> stats() const;
+
+        size_t size() const
+        {
+            return bindings_.size();
+        }
+
+    private:
+
+        using Decoder = std::function<bool(const FrozenNode& node, ErrorSink* error_sink)>;
+
+        struct Binding
+        {
+            size_t id;
+            std::vector<std::string> segments;
+            Decoder decode;
+            BindingStats stats;
+            bool is_pending; ///< added since the last update
+        };
+
+        std::vector<Binding> bindings_;
+        size_t next_id_{0};
+        std::shared_ptr<const FrozenTree> tree_;
+
+        size_t addBinding(const std::string& path, const Decoder& decode);
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_PARAMETER_REGISTRY_H
@@ -45,6 +45,7 @@
 #include <geometry_common/Pose2D.h>
 #endif // USE_GEOMETRY_COMMON
 #include <yaml-cpp/yaml.h>
+#include <yaml_common/KeyFilter.h>
 
 namespace kelo
 {
@@ -276,7 +277,8 @@ class Parser
      * data structure
      *
      * @param node The YAML node to be parsed
-     * @return std::vector<std::string> The list of keys
+     * @return std::vector<std::string> The list of keys (empty if the node is
+     * not a map)
      */
     static std::vector<std::string> getAllKeys(const YAML::Node& node);
 
@@ -286,12 +288,24 @@ class Parser
      *
      * @param values The YAML node to be copied
      * @param yaml The object where the YAML data should be copied to
-     * @param skipKeys List of keys to be skipped during copying of YAML data
+     * @param skipKeys List of root keys to be skipped during copying of YAML
+     * data
      */
     static void copyYaml(
         const YAML::Node& values, YAML::Emitter& yaml,
         const std::vector<std::string>& skipKeys = std::vector<std::string>());
 
+    /**
+     * @brief Copy YAML data like above, leaving out the keys and key paths
+     * given by filter at any depth. Skipped subtrees are not visited.
+     *
+     * @param values The YAML node to be copied
+     * @param yaml The object where the YAML data should be copied to
+     * @param filter Keys and key paths to be skipped
+     */
+    static void copyYaml(const YAML::Node& values, YAML::Emitter& yaml,
+                         const KeyFilter& filter);
+
     /**
      * @brief Copy (and overwrite) values to target node, leave other keys in
      * target untouched. Only copies root keys of map types.
@@ -41,8 +41,18 @@
 #ifndef KELO_YAML_COMMON_PARSER_2_H
 #define KELO_YAML_COMMON_PARSER_2_H
 
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
+#include <yaml_common/Check.h>
+#include <yaml_common/ErrorCode.h>
+#include <yaml_common/NumericScalar.h>
+
 #ifdef USE_GEOMETRY_COMMON
 #include <yaml_common/conversions/GeometryCommon.h>
 #endif // USE_GEOMETRY_COMMON
@@ -52,6 +62,75 @@ namespace kelo
 namespace yaml_common
 {
 
+/**
+ * @brief Outcome of a non-throwing decode of a YAML node
+ */
+enum class DecodeStatus
+{
+    SUCCESS, ///< node was decoded into the requested type
+    INVALID_NODE, ///< node is invalid or undefined (e.g. a missing key)
+    BAD_CONVERSION ///< node exists but could not be converted
+};
+
+/**
+ * @brief Kind of difference between two YAML trees at a key path
+ */
+enum class ChangeType
+{
+    ADDED, ///< path only exists in the new tree
+    REMOVED, ///< path only exists in the old tree
+    CHANGED ///< value at path differs in type, tag or scalar
+};
+
+/**
+ * @brief Difference between two YAML trees found by Parser2::diffYAML
+ */
+struct PathChange
+{
+    ChangeType type;
+    /* map keys and sequence indices joined with '/' ("" for the root) */
+    std::string path;
+};
+
+/**
+ * @brief How Parser2::loadFile reads a file from disk
+ */
+enum class FileLoadMode
+{
+    STREAM, ///< read through an `std::ifstream` (as `YAML::LoadFile`)
+    MEMORY_MAP, ///< map the file into memory and parse it from there
+    SNAPSHOT ///< use the sidecar Snapshot of the file if it is up to date,
+             ///< otherwise parse as MEMORY_MAP and (re)write the sidecar
+};
+
+namespace detail
+{
+
+/**
+ * @brief Non-throwing decoder used by all Parser2 templates. Defaults to
+ * `YAML::convert<T>::decode`; specialised for types whose yaml-cpp conversion
+ * differs from `decode` or throws internally (e.g. std::vector), and for bool
+ * and numbers, which are converted by NumericScalar.
+ */
+template <typename T, typename Enable = void>
+struct Decoder;
+
+/**
+ * @brief Decoder and validator of FrozenNode used by the Parser2 FrozenNode
+ * overloads. Defaults to decoding a thawed copy of the node; specialised for
+ * types read directly from the frozen data.
+ */
+template <typename T, typename Enable = void>
+struct FrozenDecoder;
+
+} // namespace detail
+
+class ErrorSink;
+class FileCache;
+class FrozenNode;
+class FrozenTree;
+class IndexedNode;
+
 /**
  * @brief A class with utility functions to query/parse YAML data into C++ types
  *
@@ -74,6 +153,128 @@ class Parser2
                 YAML::Node& node,
                 bool print_error_msg = true);
 
+        /**
+         * @brief Load a .yaml file from disk and report failures to
+         * `error_sink` (nothing is reported when it is `nullptr`)
+         */
+        static bool loadFile(
+                const std::string& abs_file_path,
+                YAML::Node& node,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Load a .yaml file from disk with error checking, reading it
+         * as given by `mode`. `FileLoadMode::MEMORY_MAP` parses the file
+         * directly from a read-only memory mapping instead of copying it
+         * through a stream buffer, which speeds up loading large files. Files
+         * that cannot be mapped (e.g. pipes) are read as a stream.
+         *
+         * @param abs_file_path Absolute path of .yaml file
+         * @param node YAML node where the loaded file's content will be read to
+         * @param mode how the file is read
+         * @param print_error_msg decides whether to print error message when
+         * loading is unsuccessful.
+         * @return bool success in loading the file
+         */
+        static bool loadFile(
+                const std::string& abs_file_path,
+                YAML::Node& node,
+                FileLoadMode mode,
+                bool print_error_msg = true);
+
+        /**
+         * @brief Load a .yaml file from disk, reading it as given by `mode`,
+         * and report failures to `error_sink` (nothing is reported when it is
+         * `nullptr`)
+         */
+        static bool loadFile(
+                const std::string& abs_file_path,
+                YAML::Node& node,
+                FileLoadMode mode,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Load a .yaml file from disk as an immutable FrozenTree.
+         * With a FileCache installed (see `setFileCache`) a file that did not
+         * change since it was last parsed is not copied: `tree` is set to the
+         * cached tree, which may be shared with other callers and threads.
+         *
+         * @param abs_file_path Absolute path of .yaml file
+         * @param tree set to the tree of the file's content on success
+         * @param print_error_msg decides whether to print error message when
+         * loading is unsuccessful.
+         * @return bool success in loading the file
+         */
+        static bool loadFile(
+                const std::string& abs_file_path,
+                std::shared_ptr<const FrozenTree>& tree,
+                bool print_error_msg = true);
+
+        static bool loadFile(
+                const std::string& abs_file_path,
+                std::shared_ptr<const FrozenTree>& tree,
+                ErrorSink* error_sink);
+
+        static bool loadFile(
+                const std::string& abs_file_path,
+                std::shared_ptr<const FrozenTree>& tree,
+                FileLoadMode mode,
+                bool print_error_msg = true);
+
+        static bool loadFile(
+                const std::string& abs_file_path,
+                std::shared_ptr<const FrozenTree>& tree,
+                FileLoadMode mode,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Load several independent .yaml files concurrently on a
+         * bounded pool of threads
+         *
+         * example:
+         * \code
+         *     std::vector<YAML::Node> nodes;
+         *     std::vector<bool> is_loaded;
+         *     bool success = Parser2::loadFiles({robot_file, site_file, map_file},
+         *                                       nodes, is_loaded);
+         * \endcode
+         *
+         * @param abs_file_paths Absolute paths of .yaml files
+         * @param nodes YAML nodes of the files, in the order of `abs_file_paths`
+         * (null for files that could not be loaded)
+         * @param is_loaded success in loading each file, in the order of
+         * `abs_file_paths`
+         * @param max_num_of_threads upper bound on the number of threads
+         * parsing files, including the calling one (0 for the number of
+         * hardware threads)
+         * @param mode how the files are read
+         * @param print_error_msg decides whether to print error messages when
+         * loading is unsuccessful. Messages are printed after all files were
+         * loaded, in the order of `abs_file_paths`.
+         * @return bool success in loading all files
+         */
+        static bool loadFiles(
+                const std::vector<std::string>& abs_file_paths,
+                std::vector<YAML::Node>& nodes,
+                std::vector<bool>& is_loaded,
+                size_t max_num_of_threads = 0,
+                FileLoadMode mode = FileLoadMode::STREAM,
+                bool print_error_msg = true);
+
+        /**
+         * @brief Load several independent .yaml files concurrently and report
+         * failures to `error_sink` (nothing is reported when it is `nullptr`).
+         * Errors are reported from the calling thread after all files were
+         * loaded, in the order of `abs_file_paths`.
+         */
+        static bool loadFiles(
+                const std::vector<std::string>& abs_file_paths,
+                std::vector<YAML::Node>& nodes,
+                std::vector<bool>& is_loaded,
+                size_t max_num_of_threads,
+                FileLoadMode mode,
+                ErrorSink* error_sink);
+
         /**
          * @brief Read value of `node`[`key`] into `value` when possible
          *
@@ -100,18 +301,37 @@ class Parser2
                 T& value,
                 bool print_error_msg = true)
         {
-            if ( !Parser2::hasKey(node, key, print_error_msg) )
-            {
-                return false;
-            }
-            if ( !read(node[key], value, print_error_msg) )
-            {
-                std::stringstream msg;
-                msg << "Could not read YAML::Node with key " << key;
-                Parser2::log(msg.str(), print_error_msg);
-                return false;
-            }
-            return true;
+            return Parser2::read(node, key, value,
+                                 Parser2::errorSink(print_error_msg));
+        }
+
+        /**
+         * @brief Read value of `node`[`key`] into `value` when possible and
+         * report failures to `error_sink`. Errors of reads nested inside
+         * `YAML::convert<T>::decode` are reported to the same sink.
+         *
+         * example:
+         * \code
+         *     BufferedErrorSink errors;
+         *     bool success = Parser2::read<int>(node, "key", your_int_variable, &errors);
+         * \endcode
+         *
+         * @tparam T type of value to be read
+         * @param node YAML node map that needs to be parsed
+         * @param key key to be checked in node
+         * @param value variable to which the parsed values should be assigned
+         * @param error_sink receiver of errors; `nullptr` discards them
+         * without formatting any message
+         * @return bool success in reading the value
+         */
+        template <typename T>
+        static bool read(
+                const YAML::Node& node,
+                const std::string& key,
+                T& value,
+                ErrorSink* error_sink)
+        {
+            return Parser2::readKey(node, key, value, error_sink);
         }
 
         /**
@@ -138,17 +358,71 @@ class Parser2
                 T& value,
                 bool print_error_msg = true)
         {
+            return Parser2::read(node, value,
+                                 Parser2::errorSink(print_error_msg));
+        }
+
+        /**
+         * @brief Read value of `node` into `value` when possible and report
+         * failures to `error_sink` (nothing is reported when it is `nullptr`)
+         */
+        template <typename T>
+        static bool read(
+                const YAML::Node& node,
+                T& value,
+                ErrorSink* error_sink)
+        {
+            if ( Parser2::decode(node, value, error_sink) != DecodeStatus::SUCCESS )
+            {
+                Parser2::report(error_sink, ErrorCode::BAD_VALUE);
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Decode `node` into `value` without throwing or printing.
+         * `value` is only modified when decoding succeeds.
+         *
+         * example:
+         * \code
+         *     if ( Parser2::decode<int>(node, your_int_variable) == DecodeStatus::SUCCESS )
+         * \endcode
+         *
+         * @tparam T type of value to be decoded
+         * @param node YAML node that needs to be decoded
+         * @param value variable to which the decoded value should be assigned
+         * @param error_sink receiver of errors of reads nested inside
+         * `YAML::convert<T>::decode`
+         * @return DecodeStatus reason of failure or DecodeStatus::SUCCESS
+         */
+        template <typename T>
+        static DecodeStatus decode(
+                const YAML::Node& node,
+                T& value,
+                ErrorSink* error_sink = nullptr)
+        {
+            if ( !node.IsDefined() )
+            {
+                return DecodeStatus::INVALID_NODE;
+            }
+            ActiveErrorSinkGuard guard(error_sink);
+            T temp_value;
             try
             {
-                value = node.as<T>();
+                /* conversions of third party types may still call
+                 * `as<>()` internally, so guard against them */
+                if ( !detail::Decoder<T>::decode(node, temp_value) )
+                {
+                    return DecodeStatus::BAD_CONVERSION;
+                }
             }
             catch ( YAML::Exception& )
             {
-                Parser2::log("Could not read value of YAML::Node", print_error_msg);
-                return false;
+                return DecodeStatus::BAD_CONVERSION;
             }
-
-            return true;
+            value = std::move(temp_value);
+            return DecodeStatus::SUCCESS;
         }
 
         /**
@@ -172,8 +446,9 @@ class Parser2
                 const YAML::Node& node,
                 const std::string& key)
         {
-            T dummy;
-            return read(node, key, dummy, false);
+            YAML::Node child;
+            return ( Parser2::find(node, key, child, nullptr) &&
+                     Parser2::is<T>(child) );
         }
 
         /**
@@ -194,7 +469,55 @@ class Parser2
                 bool print_error_msg = true);
 
         /**
-         * @brief Check if `node` can be read as `T` datatype
+         * @brief Check if `node` contains `key` and report failures to
+         * `error_sink` (nothing is reported when it is `nullptr`)
+         */
+        static bool hasKey(
+                const YAML::Node& node,
+                const std::string& key,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Look up `key` in `node` with a single scan of the map and
+         * make `child` refer to its value. Performs the same checks as
+         * `hasKey`. Use it to avoid repeated `node[key]` lookups when the
+         * value is needed more than once.
+         *
+         * example:
+         * \code
+         *     YAML::Node child;
+         *     if ( Parser2::find(node, "key", child) && child.IsSequence() )
+         * \endcode
+         *
+         * @param node YAML map node
+         * @param key key to be looked up
+         * @param child node that is rebound to the value of `key` (its
+         * previous content is not modified). Left untouched when `key` is
+         * not found.
+         * @param print_error_msg decides whether to print error message when
+         * `key` is not found.
+         * @return true when node contains key
+         */
+        static bool find(
+                const YAML::Node& node,
+                const std::string& key,
+                YAML::Node& child,
+                bool print_error_msg = true);
+
+        /**
+         * @brief Look up `key` in `node` with a single scan and report
+         * failures to `error_sink` (nothing is reported when it is `nullptr`)
+         */
+        static bool find(
+                const YAML::Node& node,
+                const std::string& key,
+                YAML::Node& child,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Check if `node` can be read as `T` datatype. Uses
+         * `check<T>` so that `T` is not constructed when a validation-only
+         * specialisation exists.
          *
          * example:
          * \code
@@ -210,8 +533,18 @@ class Parser2
         static bool is(
                 const YAML::Node& node)
         {
-            T dummy;
-            return read(node, dummy, false);
+            if ( !node.IsDefined() )
+            {
+                return false;
+            }
+            try
+            {
+                return check<T>::validate(node);
+            }
+            catch ( YAML::Exception& )
+            {
+                return false;
+            }
         }
 
         /**
@@ -283,52 +616,790 @@ class Parser2
             bool print_error_msg = true);
 
         /**
-         * @brief Given a vector of keys, parse their values from a YAML map
-         * node.
+         * @brief Parse an ordered list of all the keys present in a YAML map
+         * and report failures to `error_sink` (nothing is reported when it is
+         * `nullptr`)
+         */
+        static bool readAllKeys(
+            const YAML::Node& node,
+            std::vector<std::string>& keys,
+            ErrorSink* error_sink);
+
+        /**
+         * @brief Collect pointers to the keys of a YAML map in order without
+         * copying them. The pointers refer to the scalars held by the map and
+         * stay valid while its data is alive and its keys are unchanged.
          *
-         * @param node YAML map node that needs to be parsed
-         * @param keys vector of keys whose values need to be read
-         * @param values vector of floats where the read values need to be
-         * assigned
+         * @param node YAML map node whose keys are collected
+         * @param keys vector to which the keys are appended (reserved for all
+         * keys of the map up front)
          * @param print_error_msg decides whether to print error message when
          * parsing is unsuccessful.
-         * @return success Only true when all the keys where parsed successfully
+         * @return success Only true when the yaml node is a map with only
+         * scalar keys
          */
-        static bool readFloats(
-                const YAML::Node& node,
-                const std::vector<std::string>& keys,
-                std::vector<float>& values,
-                bool print_error_msg = true);
+        static bool readAllKeys(
+            const YAML::Node& node,
+            std::vector<const std::string*>& keys,
+            bool print_error_msg = true);
+
+        static bool readAllKeys(
+            const YAML::Node& node,
+            std::vector<const std::string*>& keys,
+            ErrorSink* error_sink);
 
         /**
-         * @brief Merge two YAML map nodes into one. Exclusive key-value pairs
-         * from the input nodes are copied as is. For conflicting keys,
-         * values from `override_node` are used.
+         * @brief Call `visit` with each key of a YAML map in order. Keys are
+         * passed as `const std::string&` referring to the scalar held by the
+         * map, so nothing is copied or allocated.
          *
-         * @param base_node YAML map node used as base
-         * @param override_node YAML map node whose values will be used when a
-         * key is present in both nodes
-         * @return YAML map node that is a merged map of both input nodes
+         * example:
+         * \code
+         *     size_t length = 0;
+         *     Parser2::forEachKey(node, [&](const std::string& key)
+         *                         { length += key.size(); });
+         * \endcode
+         *
+         * @param node YAML map node whose keys are visited
+         * @param visit callable taking `const std::string&`
+         * @param print_error_msg decides whether to print error message when
+         * parsing is unsuccessful.
+         * @return success Only true when the yaml node is a map with only
+         * scalar keys; visiting stops at the first non-scalar key
          */
-        static YAML::Node mergeYAML(
-                const YAML::Node& base_node,
-                const YAML::Node& override_node);
+        template <typename Visitor>
+        static bool forEachKey(
+                const YAML::Node& node,
+                Visitor&& visit,
+                bool print_error_msg = true)
+        {
+            return Parser2::forEachKey(node, std::forward<Visitor>(visit),
+                                       Parser2::errorSink(print_error_msg));
+        }
 
-    protected:
+        /**
+         * @brief Call `visit` with each key of a YAML map and report failures
+         * to `error_sink` (nothing is reported when it is `nullptr`)
+         */
+        template <typename Visitor>
+        static bool forEachKey(
+                const YAML::Node& node,
+                Visitor&& visit,
+                ErrorSink* error_sink)
+        {
+            if ( !node.IsMap() )
+            {
+                Parser2::report(error_sink, ErrorCode::NOT_A_MAP);
+                return false;
+            }
+
+            for ( const auto& entry : node )
+            {
+                if ( !entry.first.IsScalar() )
+                {
+                    Parser2::report(error_sink, ErrorCode::NON_SCALAR_KEY);
+                    return false;
+                }
+                visit(entry.first.Scalar());
+            }
+            return true;
+        }
 
         /**
-         * @brief Print error message to `std::cout` if `print_error_msg` is
-         * true in red colored font
+         * @brief Call `visit` with the node of each key of a YAML map in
+         * order, including non-scalar and null keys which `forEachKey`
+         * rejects
          *
-         * @param msg Message that needs to be printed
-         * @param print_error_msg decides whether to print error message or not.
-         * If it is false, nothing gets printed.
+         * @param node YAML map node whose keys are visited
+         * @param visit callable taking `const YAML::Node&`
+         * @param print_error_msg decides whether to print error message when
+         * parsing is unsuccessful.
+         * @return success Only true when the yaml node is a map
          */
-        static void log(
-                const std::string& msg,
-                bool print_error_msg = true);
+        template <typename Visitor>
+        static bool forEachKeyNode(
+                const YAML::Node& node,
+                Visitor&& visit,
+                bool print_error_msg = true)
+        {
+            return Parser2::forEachKeyNode(node, std::forward<Visitor>(visit),
+                                           Parser2::errorSink(print_error_msg));
+        }
 
-};
+        template <typename Visitor>
+        static bool forEachKeyNode(
+                const YAML::Node& node,
+                Visitor&& visit,
+                ErrorSink* error_sink)
+        {
+            if ( !node.IsMap() )
+            {
+                Parser2::report(error_sink, ErrorCode::NOT_A_MAP);
+                return false;
+            }
+
+            for ( const auto& entry : node )
+            {
+                visit(entry.first);
+            }
+            return true;
+        }
+
+        /**
+         * @name IndexedNode overloads
+         * Same as the YAML::Node versions but keys are looked up in the hash
+         * index of an IndexedNode instead of scanning the map.
+         */
+        ///@{
+        static bool find(
+                const IndexedNode& node,
+                const std::string& key,
+                YAML::Node& child,
+                bool print_error_msg = true);
+
+        static bool find(
+                const IndexedNode& node,
+                const std::string& key,
+                YAML::Node& child,
+                ErrorSink* error_sink);
+
+        static bool hasKey(
+                const IndexedNode& node,
+                const std::string& key,
+                bool print_error_msg = true);
+
+        static bool hasKey(
+                const IndexedNode& node,
+                const std::string& key,
+                ErrorSink* error_sink);
+
+        template <typename T>
+        static bool read(
+                const IndexedNode& node,
+                const std::string& key,
+                T& value,
+                bool print_error_msg = true)
+        {
+            return Parser2::readKey(node, key, value,
+                                    Parser2::errorSink(print_error_msg));
+        }
+
+        template <typename T>
+        static bool read(
+                const IndexedNode& node,
+                const std::string& key,
+                T& value,
+                ErrorSink* error_sink)
+        {
+            return Parser2::readKey(node, key, value, error_sink);
+        }
+
+        template <typename T>
+        static bool has(
+                const IndexedNode& node,
+                const std::string& key)
+        {
+            YAML::Node child;
+            return ( Parser2::find(node, key, child, nullptr) &&
+                     Parser2::is<T>(child) );
+        }
+
+        template <typename T>
+        static T get(
+                const IndexedNode& node,
+                const std::string& key,
+                const T& default_value)
+        {
+            T value;
+            return Parser2::readKey(node, key, value, nullptr) ? value : default_value;
+        }
+
+        static bool readAllKeys(
+            const IndexedNode& node,
+            std::vector<std::string>& keys,
+            bool print_error_msg = true);
+
+        static bool readAllKeys(
+            const IndexedNode& node,
+            std::vector<std::string>& keys,
+            ErrorSink* error_sink);
+        ///@}
+
+        /**
+         * @name FrozenNode overloads
+         * Same as the YAML::Node versions but for a node of an immutable
+         * FrozenTree; safe to call from any number of threads at once. The
+         * templates are defined in FrozenNode.h.
+         */
+        ///@{
+        static bool find(
+                const FrozenNode& node,
+                const std::string& key,
+                FrozenNode& child,
+                bool print_error_msg = true);
+
+        static bool find(
+                const FrozenNode& node,
+                const std::string& key,
+                FrozenNode& child,
+                ErrorSink* error_sink);
+
+        static bool hasKey(
+                const FrozenNode& node,
+                const std::string& key,
+                bool print_error_msg = true);
+
+        static bool hasKey(
+                const FrozenNode& node,
+                const std::string& key,
+                ErrorSink* error_sink);
+
+        template <typename T>
+        static bool read(
+                const FrozenNode& node,
+                const std::string& key,
+                T& value,
+                bool print_error_msg = true)
+        {
+            return Parser2::readKey(node, key, value,
+                                    Parser2::errorSink(print_error_msg));
+        }
+
+        template <typename T>
+        static bool read(
+                const FrozenNode& node,
+                const std::string& key,
+                T& value,
+                ErrorSink* error_sink)
+        {
+            return Parser2::readKey(node, key, value, error_sink);
+        }
+
+        template <typename T>
+        static bool read(
+                const FrozenNode& node,
+                T& value,
+                bool print_error_msg = true)
+        {
+            return Parser2::read(node, value, Parser2::errorSink(print_error_msg));
+        }
+
+        template <typename T>
+        static bool read(
+                const FrozenNode& node,
+                T& value,
+                ErrorSink* error_sink)
+        {
+            if ( Parser2::decode(node, value, error_sink) != DecodeStatus::SUCCESS )
+            {
+                Parser2::report(error_sink, ErrorCode::BAD_VALUE);
+                return false;
+            }
+            return true;
+        }
+
+        template <typename T>
+        static DecodeStatus decode(
+                const FrozenNode& node,
+                T& value,
+                ErrorSink* error_sink = nullptr);
+
+        template <typename T>
+        static bool is(
+                const FrozenNode& node);
+
+        template <typename T>
+        static bool has(
+                const FrozenNode& node,
+                const std::string& key);
+
+        template <typename T>
+        static T get(
+                const FrozenNode& node,
+                const std::string& key,
+                const T& default_value)
+        {
+            T value;
+            return Parser2::readKey(node, key, value, nullptr) ? value : default_value;
+        }
+
+        template <typename T>
+        static T get(
+                const FrozenNode& node,
+                const T& default_value)
+        {
+            T value;
+            return Parser2::read(node, value, nullptr) ? value : default_value;
+        }
+
+        template <typename Visitor>
+        static bool forEachKey(
+                const FrozenNode& node,
+                Visitor&& visit,
+                bool print_error_msg = true)
+        {
+            return Parser2::forEachKey(node, std::forward<Visitor>(visit),
+                                       Parser2::errorSink(print_error_msg));
+        }
+
+        template <typename Visitor>
+        static bool forEachKey(
+                const FrozenNode& node,
+                Visitor&& visit,
+                ErrorSink* error_sink);
+
+        static bool readAllKeys(
+            const FrozenNode& node,
+            std::vector<std::string>& keys,
+            bool print_error_msg = true);
+
+        static bool readAllKeys(
+            const FrozenNode& node,
+            std::vector<std::string>& keys,
+            ErrorSink* error_sink);
+        ///@}
+
+        /**
+         * @brief Given a vector of keys, parse their values from a YAML map
+         * node.
+         *
+         * @param node YAML map node that needs to be parsed
+         * @param keys vector of keys whose values need to be read
+         * @param values vector of floats where the read values need to be
+         * assigned
+         * @param print_error_msg decides whether to print error message when
+         * parsing is unsuccessful.
+         * @return success Only true when all the keys where parsed successfully
+         */
+        static bool readFloats(
+                const YAML::Node& node,
+                const std::vector<std::string>& keys,
+                std::vector<float>& values,
+                bool print_error_msg = true);
+
+        /**
+         * @brief Given a vector of keys, parse their values from a YAML map
+         * node and report failures to `error_sink` (nothing is reported when
+         * it is `nullptr`)
+         */
+        static bool readFloats(
+                const YAML::Node& node,
+                const std::vector<std::string>& keys,
+                std::vector<float>& values,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Merge two YAML map nodes into one. Exclusive key-value pairs
+         * from the input nodes are copied as is. For conflicting keys,
+         * values from `override_node` are used.
+         *
+         * @param base_node YAML map node used as base
+         * @param override_node YAML map node whose values will be used when a
+         * key is present in both nodes
+         * @return YAML map node that is a merged map of both input nodes
+         */
+        static YAML::Node mergeYAML(
+                const YAML::Node& base_node,
+                const YAML::Node& override_node);
+
+        /**
+         * @brief Merge `override_node` into `base_node` in place. The result is
+         * the same as `base_node = mergeYAML(base_node, override_node)`, but
+         * only the maps along the keys of `override_node` are visited and
+         * nothing of `base_node` is copied, so applying a small override to a
+         * large tree is cheap. Values taken from `override_node` are cloned,
+         * so later changes to either node do not affect the other.
+         *
+         * @note Subtrees of `base_node` are modified, so it must not share
+         * them with nodes that are expected to stay unchanged (e.g. it must
+         * not be a result of `mergeYAML`, which shares subtrees with its
+         * inputs, unless those may change as well). Use `YAML::Clone` first
+         * in that case.
+         *
+         * @param base_node YAML node that is updated with the merge result
+         * @param override_node YAML map node whose values will be used when a
+         * key is present in both nodes
+         */
+        static void mergeYAMLInPlace(
+                YAML::Node& base_node,
+                const YAML::Node& override_node);
+
+        /**
+         * @brief Merge a stack of YAML nodes in a single traversal. The result
+         * is the same as folding `mergeYAML` over `layers` from first to last,
+         * i.e. later layers override earlier ones, but no intermediate tree is
+         * built.
+         *
+         * example:
+         * \code
+         *     std::map<std::string, size_t> origins;
+         *     YAML::Node config = Parser2::mergeLayers(
+         *             {defaults, robot_model, site, runtime}, &origins);
+         *     // origins["controller/max_vel"] == 2 if site sets it last
+         * \endcode
+         *
+         * @param layers YAML nodes ordered from lowest to highest precedence
+         * @param origins if not `nullptr`, filled with the index of the layer
+         * each leaf of the result was taken from. Leaves are keyed by their
+         * scalar keys joined with '/' (the empty string for a leaf root) and
+         * are scalars, sequences, nulls and empty maps. Entries with
+         * non-scalar keys are not recorded.
+         * @return YAML::Node merged node (a null node if `layers` is empty)
+         */
+        static YAML::Node mergeLayers(
+                const std::vector<YAML::Node>& layers,
+                std::map<std::string, size_t>* origins = nullptr);
+
+        /**
+         * @brief List the key paths at which two YAML trees differ. Maps are
+         * compared key by key regardless of order, sequences index by index.
+         * The list is compact: an added or removed subtree is one change at
+         * its root, and values that differ in type or scalar (or maps with
+         * non-scalar keys that differ) are one CHANGED at their path.
+         *
+         * example:
+         * \code
+         *     std::vector<PathChange> changes;
+         *     Parser2::diffYAML(old_config, new_config, changes);
+         *     // {CHANGED, "controller/max_vel"}, {ADDED, "sensors/2"}
+         * \endcode
+         *
+         * Subtrees that are the same node (see `YAML::Node::is`, e.g. shared
+         * by `mergeYAML`) are skipped, all others are walked. Use the
+         * FrozenNode overload to skip identical subtrees of independently
+         * parsed trees.
+         *
+         * @param old_node YAML node before the change
+         * @param new_node YAML node after the change
+         * @param changes vector to which the differences are appended
+         */
+        static void diffYAML(
+                const YAML::Node& old_node,
+                const YAML::Node& new_node,
+                std::vector<PathChange>& changes);
+
+        /**
+         * @brief List the key paths at which two frozen trees differ (see
+         * above). Subtrees with equal hashes (see `FrozenNode::hash`) are
+         * skipped, so the cost depends on the size of the maps along changed
+         * paths, not on the size of the trees. A change is only missed if
+         * it leaves the 64 bit hash of its subtree unchanged.
+         */
+        static void diffYAML(
+                const FrozenNode& old_node,
+                const FrozenNode& new_node,
+                std::vector<PathChange>& changes);
+
+        /**
+         * @brief Sink receiving the errors of all functions called with
+         * `print_error_msg` set to true. Defaults to a ConsoleErrorSink
+         * writing to `std::cout`.
+         *
+         * @return ErrorSink* current default sink (may be `nullptr`)
+         */
+        static ErrorSink* defaultErrorSink();
+
+        /**
+         * @brief Route errors of all functions called with `print_error_msg`
+         * set to true to `error_sink`, e.g. a BufferedErrorSink or an
+         * AsyncErrorSink to keep terminal I/O out of startup. `nullptr`
+         * silences them. The sink must outlive its use by Parser2.
+         *
+         * @param error_sink new default sink
+         */
+        static void setDefaultErrorSink(ErrorSink* error_sink);
+
+        /**
+         * @brief Cache used by all `loadFile` calls, or `nullptr` (default)
+         * if files are parsed on every call
+         */
+        static FileCache* fileCache();
+
+        /**
+         * @brief Make all `loadFile` calls of the process reuse the cached
+         * tree of a file that did not change since it was last parsed (see
+         * FileCache). The FrozenTree overloads share the cached tree, the
+         * YAML::Node overloads return a thawed copy of it. `nullptr` disables
+         * caching. The cache must outlive its use by Parser2.
+         *
+         * @param file_cache new cache
+         */
+        static void setFileCache(FileCache* file_cache);
+
+        /**
+         * @brief Sink that reads nested inside `YAML::convert<T>::decode`
+         * should report to. Inside a Parser2 read this is the sink of that
+         * read (possibly `nullptr`), otherwise it is `defaultErrorSink()`.
+         *
+         * example:
+         * \code
+         *     bool convert<YourType>::decode(const Node& node, YourType& value)
+         *     {
+         *         return Parser2::read<float>(node, "x", value.x,
+         *                                     Parser2::activeErrorSink());
+         *     }
+         * \endcode
+         *
+         * @return ErrorSink* sink for nested reads (may be `nullptr`)
+         */
+        static ErrorSink* activeErrorSink()
+        {
+            return ( is_error_sink_active_ ) ? active_error_sink_
+                                             : Parser2::defaultErrorSink();
+        }
+
+    protected:
+
+        /**
+         * @brief Print error message to `std::cout` if `print_error_msg` is
+         * true in red colored font
+         *
+         * @param msg Message that needs to be printed
+         * @param print_error_msg decides whether to print error message or not.
+         * If it is false, nothing gets printed.
+         */
+        static void log(
+                const std::string& msg,
+                bool print_error_msg = true);
+
+        /**
+         * @brief Read and parse a .yaml file as given by `mode` without
+         * looking at the FileCache
+         */
+        static bool parseFile(
+                const std::string& abs_file_path,
+                YAML::Node& node,
+                FileLoadMode mode,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Read the value of `key` of a YAML::Node or IndexedNode map
+         */
+        template <typename T, typename MapNode>
+        static bool readKey(
+                const MapNode& node,
+                const std::string& key,
+                T& value,
+                ErrorSink* error_sink)
+        {
+            YAML::Node child;
+            if ( !Parser2::find(node, key, child, error_sink) )
+            {
+                return false;
+            }
+            if ( !Parser2::read(child, value, error_sink) )
+            {
+                Parser2::report(error_sink, ErrorCode::BAD_VALUE_FOR_KEY, key);
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Read the value of `key` of a FrozenNode map
+         */
+        template <typename T>
+        static bool readKey(
+                const FrozenNode& node,
+                const std::string& key,
+                T& value,
+                ErrorSink* error_sink);
+
+        /**
+         * @brief Sink corresponding to the legacy `print_error_msg` flag
+         */
+        static ErrorSink* errorSink(bool print_error_msg)
+        {
+            return ( print_error_msg ) ? Parser2::defaultErrorSink() : nullptr;
+        }
+
+        /**
+         * @brief Report an error to `error_sink` if someone is listening
+         */
+        static void report(
+                ErrorSink* error_sink,
+                ErrorCode code,
+                const std::string& detail = std::string());
+
+        /**
+         * @brief Make `error_sink` the active sink of the current thread for
+         * the lifetime of the guard
+         */
+        class ActiveErrorSinkGuard
+        {
+            public:
+
+                explicit ActiveErrorSinkGuard(ErrorSink* error_sink):
+                    prev_sink_(active_error_sink_),
+                    prev_is_active_(is_error_sink_active_)
+                {
+                    active_error_sink_ = error_sink;
+                    is_error_sink_active_ = true;
+                }
+
+                ~ActiveErrorSinkGuard()
+                {
+                    active_error_sink_ = prev_sink_;
+                    is_error_sink_active_ = prev_is_active_;
+                }
+
+            private:
+
+                ErrorSink* prev_sink_;
+                bool prev_is_active_;
+
+        };
+
+        static thread_local ErrorSink* active_error_sink_;
+        static thread_local bool is_error_sink_active_;
+
+#ifdef YAML_COMMON_COUNT_KEY_LOOKUPS
+        /**
+         * @brief Number of map scans performed by `find` on the current
+         * thread. Only compiled into the library built for the tests.
+         */
+        static thread_local size_t num_of_key_lookups_;
+#endif // YAML_COMMON_COUNT_KEY_LOOKUPS
+
+};
+
+namespace detail
+{
+
+template <typename T, typename Enable>
+struct Decoder
+{
+    static bool decode(const YAML::Node& node, T& value)
+    {
+        return YAML::convert<T>::decode(node, value);
+    }
+};
+
+/* same result as `YAML::convert<T>::decode` without its `std::stringstream` */
+template <typename T>
+struct Decoder<T, typename std::enable_if<NumericScalar::is_supported<T>::value>::type>
+{
+    static bool decode(const YAML::Node& node, T& value)
+    {
+        return ( node.IsScalar() && NumericScalar::parse(node.Scalar(), value) );
+    }
+};
+
+/* `as<std::string>()` reads a null node as "null" */
+template <>
+struct Decoder<std::string>
+{
+    static bool decode(const YAML::Node& node, std::string& value)
+    {
+        if ( node.IsNull() )
+        {
+            value = "null";
+            return true;
+        }
+        if ( !node.IsScalar() )
+        {
+            return false;
+        }
+        value = node.Scalar();
+        return true;
+    }
+};
+
+/* `YAML::convert<std::vector<T>>` throws on the first bad element */
+template <typename T, typename A>
+struct Decoder<std::vector<T, A>>
+{
+    static bool decode(const YAML::Node& node, std::vector<T, A>& value)
+    {
+        if ( !node.IsSequence() )
+        {
+            return false;
+        }
+        return decodeElements(node, value, NumericScalar::is_supported<T>());
+    }
+
+    static bool decodeElements(const YAML::Node& node, std::vector<T, A>& value,
+                               std::false_type /*is_numeric*/)
+    {
+        value.clear();
+        value.reserve(node.size());
+        for ( const auto& element : node )
+        {
+            T element_value;
+            if ( Parser2::decode(element, element_value) != DecodeStatus::SUCCESS )
+            {
+                return false;
+            }
+            value.push_back(std::move(element_value));
+        }
+        return true;
+    }
+
+    /* sequences of numbers are converted in a single loop, without the
+     * per element overhead of Parser2::decode */
+    static bool decodeElements(const YAML::Node& node, std::vector<T, A>& value,
+                               std::true_type /*is_numeric*/)
+    {
+        value.resize(node.size());
+        size_t i = 0;
+        for ( const auto& element : node )
+        {
+            T element_value;
+            if ( !element.IsScalar() || !NumericScalar::parse(element.Scalar(), element_value) )
+            {
+                return false;
+            }
+            value[i++] = element_value;
+        }
+        return true;
+    }
+};
+
+} // namespace detail
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+/* fall back to decoding into a temporary */
+template <typename T>
+struct check
+{
+    static bool validate(const YAML::Node& node)
+    {
+        T dummy;
+        return ( Parser2::decode(node, dummy) == DecodeStatus::SUCCESS );
+    }
+};
+
+template <>
+struct check<std::string>
+{
+    static bool validate(const YAML::Node& node)
+    {
+        return ( node.IsNull() || node.IsScalar() );
+    }
+};
+
+template <typename T, typename A>
+struct check<std::vector<T, A>>
+{
+    static bool validate(const YAML::Node& node)
+    {
+        if ( !node.IsSequence() )
+        {
+            return false;
+        }
+        for ( const auto& element : node )
+        {
+            if ( !Parser2::is<T>(element) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 } // namespace yaml_common
 } // namespace kelo
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_SNAPSHOT_H
+#define KELO_YAML_COMMON_SNAPSHOT_H
+
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Compact binary form of a parsed YAML::Node tree that loads without
+ * tokenizing or parsing text.
+ *
+ * A snapshot keeps everything `YAML::Dump` relies on: node types, scalars,
+ * tags, styles, order of map entries, and nodes shared through anchors and
+ * aliases. Source positions (`YAML::Node::Mark`) are not kept.
+ *
+ * Parser2::loadFile with `FileLoadMode::SNAPSHOT` uses a sidecar snapshot
+ * (see `sidecarPath`) written for the current version of a file, i.e. with
+ * the same modification time and size it had when the snapshot was saved.
+ *
+ * @note The format depends on the byte order of the machine writing it;
+ * snapshots from a machine of different byte order are rejected.
+ */
+class Snapshot
+{
+    public:
+
+        /**
+         * @brief Serialize `node` into a snapshot
+         *
+         * @param node YAML node to serialize
+         * @param data snapshot of `node` (overwritten)
+         */
+        static void serialize(const YAML::Node& node, std::string& data);
+
+        /**
+         * @brief Rebuild a YAML node from a snapshot created by `serialize`
+         *
+         * @param data pointer to the snapshot
+         * @param size size of the snapshot in bytes
+         * @param node YAML node where the snapshot's content will be read to
+         * @return bool false if `data` is not a valid snapshot
+         */
+        static bool deserialize(const char* data, size_t size, YAML::Node& node);
+
+        /**
+         * @brief Write a snapshot of `node` to a file
+         *
+         * @param node YAML node to serialize
+         * @param file_path path of the snapshot file
+         * @return bool success in writing the file
+         */
+        static bool save(const YAML::Node& node, const std::string& file_path);
+
+        /**
+         * @brief Load a snapshot file written by `save` or `saveSidecar`
+         *
+         * @param file_path path of the snapshot file
+         * @param node YAML node where the snapshot's content will be read to
+         * @return bool false if the file could not be read or is not a valid
+         * snapshot
+         */
+        static bool load(const std::string& file_path, YAML::Node& node);
+
+        /**
+         * @brief Path of the sidecar snapshot of a .yaml file
+         *
+         * @param abs_file_path absolute path of .yaml file
+         * @return std::string `abs_file_path` with ".snapshot" appended
+         */
+        static std::string sidecarPath(const std::string& abs_file_path);
+
+        /**
+         * @brief Write the sidecar snapshot of the .yaml file `abs_file_path`,
+         * whose parsed content is `node`. The snapshot records the current
+         * modification time and size of the file and is replaced atomically.
+         *
+         * @return bool success in writing the sidecar
+         */
+        static bool saveSidecar(const std::string& abs_file_path,
+                                const YAML::Node& node);
+
+        /**
+         * @brief Load the sidecar snapshot of the .yaml file `abs_file_path`
+         * if it was written for the current version of the file
+         *
+         * @return bool false if there is no valid sidecar for the current
+         * version of the file
+         */
+        static bool loadSidecar(const std::string& abs_file_path,
+                                YAML::Node& node);
+
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_SNAPSHOT_H
@@ -0,0 +1,620 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_YAML_COMMON_STREAM_READER_H
+#define KELO_YAML_COMMON_STREAM_READER_H
+
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/NumericScalar.h>
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+namespace detail
+{
+
+/**
+ * @brief Receiver of the parser events of the elements of a streamed sequence.
+ * Events of each element are followed by `onElementEnd`.
+ */
+class ElementHandler
+{
+    public:
+
+        virtual ~ElementHandler() {}
+
+        virtual void onNull() = 0;
+
+        virtual void onScalar(const std::string& tag, const std::string& value) = 0;
+
+        virtual void onSequenceStart(const std::string& tag,
+                                     YAML::EmitterStyle::value style) = 0;
+
+        virtual void onMapStart(const std::string& tag,
+                                YAML::EmitterStyle::value style) = 0;
+
+        /**
+         * @brief End of the innermost sequence or map
+         */
+        virtual void onEnd() = 0;
+
+        /**
+         * @brief All events of the element at `index` were received
+         *
+         * @return bool false to stop reading
+         */
+        virtual bool onElementEnd(size_t index) = 0;
+
+        /**
+         * @brief Whether reading stopped because an element could not be
+         * decoded
+         */
+        bool isFailed() const
+        {
+            return is_failed_;
+        }
+
+    protected:
+
+        bool is_failed_{false};
+
+};
+
+/**
+ * @brief Build a YAML::Node holding a single element out of its events
+ */
+class ElementNodeBuilder : public ElementHandler
+{
+    public:
+
+        void onNull() override;
+
+        void onScalar(const std::string& tag, const std::string& value) override;
+
+        void onSequenceStart(const std::string& tag,
+                             YAML::EmitterStyle::value style) override;
+
+        void onMapStart(const std::string& tag,
+                        YAML::EmitterStyle::value style) override;
+
+        void onEnd() override;
+
+    protected:
+
+        /**
+         * @brief Node of the element completed last
+         */
+        const YAML::Node& element() const
+        {
+            return element_;
+        }
+
+    private:
+
+        struct Frame
+        {
+            YAML::Node node;
+            YAML::Node key;
+            bool has_key;
+        };
+
+        void add(const YAML::Node& node, bool is_container);
+
+        YAML::Node element_;
+        std::vector<Frame> stack_;
+
+};
+
+/**
+ * @brief Path of an element in error messages, e.g. "zones/polygon[3]"
+ */
+std::string elementPath(const std::vector<std::string>& key_path, size_t index);
+
+/**
+ * @brief Decode each element with Parser2::decode from a node built for that
+ * element alone. Works for every type Parser2 can read.
+ */
+template <typename T>
+class NodeElementDecoder : public ElementNodeBuilder
+{
+    public:
+
+        NodeElementDecoder(const std::vector<std::string>& key_path,
+                           const std::function<bool(T&)>& callback,
+                           ErrorSink* error_sink):
+            key_path_(key_path),
+            callback_(callback),
+            error_sink_(error_sink) {}
+
+        bool onElementEnd(size_t index) override
+        {
+            T value;
+            if ( Parser2::decode<T>(element(), value, error_sink_) != DecodeStatus::SUCCESS )
+            {
+                if ( error_sink_ )
+                {
+                    const std::string detail = elementPath(key_path_, index);
+                    error_sink_->report(Error(ErrorCode::BAD_VALUE_FOR_KEY, detail));
+                }
+                is_failed_ = true;
+                return false;
+            }
+            return callback_(value);
+        }
+
+    private:
+
+        const std::vector<std::string>& key_path_;
+        const std::function<bool(T&)>& callback_;
+        ErrorSink* error_sink_;
+
+};
+
+/**
+ * @brief Types that are maps of float fields can be streamed without building
+ * any node. Specialisations provide:
+ * - `enum { size = N };` the number of fields
+ * - `static const char* name(size_t i);` key of field `i`
+ * - `static T make(const float* values);` value from the fields in order
+ */
+template <typename T>
+struct float_fields;
+
+/**
+ * @brief Decode each element directly from its events into the fields of a
+ * `float_fields` type. Accepts exactly what Parser2::read accepts: a map with
+ * all fields (additional keys are ignored, the first of duplicate keys wins).
+ */
+template <typename T>
+class FloatFieldsDecoder : public ElementHandler
+{
+    public:
+
+        FloatFieldsDecoder(const std::vector<std::string>& key_path,
+                           const std::function<bool(T&)>& callback,
+                           ErrorSink* error_sink):
+            key_path_(key_path),
+            callback_(callback),
+            error_sink_(error_sink) {}
+
+        void onNull() override
+        {
+            onValue(nullptr);
+        }
+
+        void onScalar(const std::string& /*tag*/, const std::string& value) override
+        {
+            if ( depth_ == 1 && is_key_next_ )
+            {
+                field_ = -1;
+                for ( size_t i = 0; i < float_fields<T>::size; i++ )
+                {
+                    if ( value == float_fields<T>::name(i) )
+                    {
+                        field_ = static_cast<int>(i);
+                        break;
+                    }
+                }
+                is_key_next_ = false;
+                return;
+            }
+            onValue(&value);
+        }
+
+        void onSequenceStart(const std::string& /*tag*/,
+                             YAML::EmitterStyle::value /*style*/) override
+        {
+            onContainerStart();
+        }
+
+        void onMapStart(const std::string& /*tag*/,
+                        YAML::EmitterStyle::value /*style*/) override
+        {
+            if ( depth_ == 0 )
+            {
+                depth_ = 1;
+                is_map_ = true;
+                is_key_next_ = true;
+                num_of_seen_fields_ = 0;
+                for ( size_t i = 0; i < float_fields<T>::size; i++ )
+                {
+                    is_seen_[i] = false;
+                }
+                return;
+            }
+            onContainerStart();
+        }
+
+        void onEnd() override
+        {
+            depth_--;
+        }
+
+        bool onElementEnd(size_t index) override
+        {
+            depth_ = 0;
+            if ( !is_map_ || num_of_seen_fields_ != float_fields<T>::size )
+            {
+                if ( error_sink_ )
+                {
+                    const std::string detail = elementPath(key_path_, index);
+                    error_sink_->report(Error(ErrorCode::BAD_VALUE_FOR_KEY, detail));
+                }
+                is_failed_ = true;
+                return false;
+            }
+            is_map_ = false;
+            T value = float_fields<T>::make(values_);
+            return callback_(value);
+        }
+
+    private:
+
+        /**
+         * @brief A scalar or null at the current position
+         */
+        void onValue(const std::string* value)
+        {
+            if ( depth_ == 0 )
+            {
+                is_map_ = false; // element is not a map
+                return;
+            }
+            if ( depth_ > 1 )
+            {
+                return;
+            }
+            if ( is_key_next_ )
+            {
+                field_ = -1; // null key
+                is_key_next_ = false;
+                return;
+            }
+            is_key_next_ = true;
+            if ( field_ < 0 || is_seen_[field_] )
+            {
+                return;
+            }
+            is_seen_[field_] = true;
+            if ( value && NumericScalar::parse(*value, values_[field_]) )
+            {
+                num_of_seen_fields_++;
+            }
+        }
+
+        /**
+         * @brief A sequence or map inside the element map (as key or value)
+         */
+        void onContainerStart()
+        {
+            if ( depth_ == 0 )
+            {
+                is_map_ = false;
+            }
+            else if ( depth_ == 1 )
+            {
+                if ( is_key_next_ )
+                {
+                    field_ = -1; // non-scalar key
+                }
+                else if ( field_ >= 0 )
+                {
+                    is_seen_[field_] = true; // non-scalar value
+                }
+                is_key_next_ = !is_key_next_;
+            }
+            depth_++;
+        }
+
+        const std::vector<std::string>& key_path_;
+        const std::function<bool(T&)>& callback_;
+        ErrorSink* error_sink_;
+        size_t depth_{0};
+        bool is_map_{false};
+        bool is_key_next_{true};
+        int field_{-1};
+        bool is_seen_[float_fields<T>::size];
+        float values_[float_fields<T>::size];
+        size_t num_of_seen_fields_{0};
+
+};
+
+/**
+ * @brief Element decoder used by StreamReader for `T`
+ */
+template <typename T>
+struct StreamDecoder
+{
+    using type = NodeElementDecoder<T>;
+};
+
+/**
+ * @brief Stream the sequence at `key_path` of the first document of `input`
+ * into `handler`
+ *
+ * @return bool false if the sequence was not found or `input` is not valid
+ * YAML (reported to `error_sink`), or if `handler` failed
+ */
+bool streamSequence(std::istream& input,
+                    const std::vector<std::string>& key_path,
+                    ElementHandler& handler,
+                    ErrorSink* error_sink);
+
+} // namespace detail
+
+/**
+ * @brief Read a sequence out of a YAML document without building a
+ * YAML::Node tree of the document. The parser events are followed down the
+ * given key path, everything else is skipped, and each element of the
+ * sequence is decoded on its own as soon as it was parsed. Peak memory is
+ * thus the decoded data plus a single element, instead of a node per scalar
+ * and map of the whole document.
+ *
+ * example:
+ * \code
+ *     // zones.yaml:
+ *     //   zones:
+ *     //     restricted:
+ *     //       polygon: [{x: 0, y: 0}, {x: 1, y: 0}, ...]
+ *     Polygon2D polygon;
+ *     bool success = StreamReader::loadSequence<Point2D>(
+ *             "/path/zones.yaml", {"zones", "restricted", "polygon"},
+ *             polygon.vertices);
+ * \endcode
+ *
+ * Elements are decoded as Parser2::read would decode them. Aliases are not
+ * supported within the path or the sequence. Reading stops at the end of the
+ * sequence, so errors in the rest of the document are not detected.
+ */
+class StreamReader
+{
+    public:
+
+        template <typename T>
+        using Callback = std::function<bool(T& value)>;
+
+        /**
+         * @brief Call `callback` with each element of the sequence at
+         * `key_path` in the first document of `input`
+         *
+         * @param input stream of a YAML document
+         * @param key_path keys of the nested maps leading to the sequence
+         * (empty if the document is the sequence)
+         * @param callback called with each decoded element in order; returning
+         * false stops reading (which is not a failure)
+         * @param print_error_msg decides whether to print error messages
+         * @return bool success in finding and decoding the sequence
+         */
+        template <typename T>
+        static bool readSequence(
+                std::istream& input,
+                const std::vector<std::string>& key_path,
+                const Callback<T>& callback,
+                bool print_error_msg = true)
+        {
+            return StreamReader::readSequence<T>(input, key_path, callback,
+                    ( print_error_msg ) ? Parser2::defaultErrorSink() : nullptr);
+        }
+
+        /**
+         * @brief Call `callback` with each element of the sequence at
+         * `key_path` and report failures to `error_sink` (nothing is reported
+         * when it is `nullptr`)
+         */
+        template <typename T>
+        static bool readSequence(
+                std::istream& input,
+                const std::vector<std::string>& key_path,
+                const Callback<T>& callback,
+                ErrorSink* error_sink)
+        {
+            typename detail::StreamDecoder<T>::type decoder(key_path, callback,
+                                                            error_sink);
+            return detail::streamSequence(input, key_path, decoder, error_sink);
+        }
+
+        /**
+         * @brief Read the sequence at `key_path` in the first document of
+         * `input` into `values`
+         *
+         * @param input stream of a YAML document
+         * @param key_path keys of the nested maps leading to the sequence
+         * @param values decoded elements (overwritten)
+         * @param print_error_msg decides whether to print error messages
+         * @return bool success in finding and decoding the sequence
+         */
+        template <typename T>
+        static bool readSequence(
+                std::istream& input,
+                const std::vector<std::string>& key_path,
+                std::vector<T>& values,
+                bool print_error_msg = true)
+        {
+            return StreamReader::readSequence<T>(input, key_path, values,
+                    ( print_error_msg ) ? Parser2::defaultErrorSink() : nullptr);
+        }
+
+        /**
+         * @brief Read the sequence at `key_path` into `values` and report
+         * failures to `error_sink` (nothing is reported when it is `nullptr`)
+         */
+        template <typename T>
+        static bool readSequence(
+                std::istream& input,
+                const std::vector<std::string>& key_path,
+                std::vector<T>& values,
+                ErrorSink* error_sink)
+        {
+            values.clear();
+            const Callback<T> callback = [&values](T& value)
+            {
+                values.push_back(std::move(value));
+                return true;
+            };
+            return StreamReader::readSequence<T>(input, key_path, callback,
+                                                 error_sink);
+        }
+
+        /**
+         * @brief Read the sequence at `key_path` in a .yaml file into `values`
+         *
+         * @param abs_file_path Absolute path of .yaml file
+         * @param key_path keys of the nested maps leading to the sequence
+         * @param values decoded elements (overwritten)
+         * @param print_error_msg decides whether to print error messages
+         * @return bool success in reading the file and the sequence
+         */
+        template <typename T>
+        static bool loadSequence(
+                const std::string& abs_file_path,
+                const std::vector<std::string>& key_path,
+                std::vector<T>& values,
+                bool print_error_msg = true)
+        {
+            return StreamReader::loadSequence<T>(abs_file_path, key_path, values,
+                    ( print_error_msg ) ? Parser2::defaultErrorSink() : nullptr);
+        }
+
+        /**
+         * @brief Read the sequence at `key_path` in a .yaml file into `values`
+         * and report failures to `error_sink` (nothing is reported when it is
+         * `nullptr`)
+         */
+        template <typename T>
+        static bool loadSequence(
+                const std::string& abs_file_path,
+                const std::vector<std::string>& key_path,
+                std::vector<T>& values,
+                ErrorSink* error_sink)
+        {
+            std::ifstream input(abs_file_path);
+            if ( !input )
+            {
+                if ( error_sink )
+                {
+                    error_sink->report(Error(ErrorCode::BAD_FILE, abs_file_path));
+                }
+                return false;
+            }
+            return StreamReader::readSequence<T>(input, key_path, values,
+                                                 error_sink);
+        }
+
+};
+
+#ifdef USE_GEOMETRY_COMMON
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace detail
+{
+
+template <>
+struct float_fields<geometry_common::Point2D>
+{
+    enum { size = 2 };
+
+    static const char* name(size_t i)
+    {
+        static const char* const names[] = {"x", "y"};
+        return names[i];
+    }
+
+    static geometry_common::Point2D make(const float* values)
+    {
+        geometry_common::Point2D pt;
+        pt.x = values[0];
+        pt.y = values[1];
+        return pt;
+    }
+};
+
+template <>
+struct float_fields<geometry_common::Point3D>
+{
+    enum { size = 3 };
+
+    static const char* name(size_t i)
+    {
+        static const char* const names[] = {"x", "y", "z"};
+        return names[i];
+    }
+
+    static geometry_common::Point3D make(const float* values)
+    {
+        geometry_common::Point3D pt;
+        pt.x = values[0];
+        pt.y = values[1];
+        pt.z = values[2];
+        return pt;
+    }
+};
+
+template <>
+struct StreamDecoder<geometry_common::Point2D>
+{
+    using type = FloatFieldsDecoder<geometry_common::Point2D>;
+};
+
+template <>
+struct StreamDecoder<geometry_common::Point3D>
+{
+    using type = FloatFieldsDecoder<geometry_common::Point3D>;
+};
+
+} // namespace detail
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#endif // USE_GEOMETRY_COMMON
+
+} // namespace yaml_common
+} // namespace kelo
+
+#endif // KELO_YAML_COMMON_STREAM_READER_H
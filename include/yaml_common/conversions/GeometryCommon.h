@@ -57,6 +57,8 @@
 #include <geometry_common/Polygon2D.h>
 #include <geometry_common/PointCloudProjector.h>
 
+#include <yaml_common/Check.h>
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 namespace YAML
@@ -153,7 +155,115 @@ struct convert<kelo::PointCloudProjectorConfig>
     static bool decode(const Node& node, kelo::PointCloudProjectorConfig& config);
 };
 
+/*
+ * Emit geometry types directly, without building a YAML::Node first. The
+ * output is the same as emitting the node created by `convert<T>::encode`,
+ * except that empty polylines and polygons are written as `[]` instead of
+ * `~`. The flow form (e.g. `{x: 1, y: 2}`) is selected as for any map or
+ * sequence: with `YAML::Flow` right before a value, or for all maps with
+ * `Emitter::SetMapFormat(YAML::Flow)`.
+ */
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Box2D& box);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Box3D& box);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Point2D& pt);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Point3D& pt);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::XYTheta& x_y_theta);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Pose2D& pose);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Circle& circle);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::TransformMatrix2D& tf_mat);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::TransformMatrix3D& tf_mat);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::LineSegment2D& line_segment);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Polyline2D& polyline);
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Polygon2D& polygon);
+Emitter& operator << (Emitter& out, const kelo::PointCloudProjectorConfig& config);
+
 } // namespace YAML
 
+namespace kelo
+{
+namespace yaml_common
+{
+
+template<>
+struct check<kelo::geometry_common::Box2D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::Box3D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::Point2D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::Point3D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::XYTheta>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::Pose2D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::Circle>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::TransformMatrix2D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::TransformMatrix3D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::LineSegment2D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::Polyline2D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::geometry_common::Polygon2D>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+template<>
+struct check<kelo::PointCloudProjectorConfig>
+{
+    static bool validate(const YAML::Node& node);
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 #endif // KELO_YAML_COMMON_CONVERSIONS_GEOMETRY_COMMON_H
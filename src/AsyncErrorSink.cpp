@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <yaml_common/AsyncErrorSink.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+AsyncErrorSink::AsyncErrorSink(std::ostream& out):
+    out_(out),
+    worker_(&AsyncErrorSink::run, this)
+{
+}
+
+AsyncErrorSink::~AsyncErrorSink()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+void AsyncErrorSink::report(const Error& error)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(Record{error.code(), error.detail()});
+        num_of_pending_++;
+    }
+    cv_.notify_all();
+}
+
+void AsyncErrorSink::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]{ return num_of_pending_ == 0; });
+}
+
+void AsyncErrorSink::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while ( true )
+    {
+        cv_.wait(lock, [this]{ return stop_ || !queue_.empty(); });
+        if ( queue_.empty() && stop_ )
+        {
+            break;
+        }
+
+        std::deque<Record> records;
+        records.swap(queue_);
+        lock.unlock();
+        for ( const Record& record : records )
+        {
+            out_ << "[Parser2] " << Error(record.code, record.detail).message() << "\n";
+        }
+        out_.flush();
+        lock.lock();
+
+        num_of_pending_ -= records.size();
+        cv_.notify_all();
+    }
+}
+
+} // namespace yaml_common
+} // namespace kelo
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <utility>
+
+#include <yaml_common/ChangeNotifier.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Whether `ancestor` is `path` or one of its ancestors
+ */
+static bool isAncestorOrSelf(const std::string& ancestor, const std::string& path)
+{
+    return ( ancestor.empty() ||
+             ( path.compare(0, ancestor.size(), ancestor) == 0 &&
+               ( path.size() == ancestor.size() || path[ancestor.size()] == '/' ) ) );
+}
+
+bool ChangeNotifier::isAffected(const std::string& prefix, const std::string& path)
+{
+    return ( isAncestorOrSelf(prefix, path) || isAncestorOrSelf(path, prefix) );
+}
+
+size_t ChangeNotifier::subscribe(const std::string& prefix, const Callback& callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscriptions_.push_back(Subscription{next_id_, prefix, callback});
+    return next_id_++;
+}
+
+bool ChangeNotifier::unsubscribe(size_t id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for ( auto it = subscriptions_.begin(); it != subscriptions_.end(); ++it )
+    {
+        if ( it->id == id )
+        {
+            subscriptions_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChangeNotifier::update(const std::shared_ptr<const FrozenTree>& tree)
+{
+    std::shared_ptr<const FrozenTree> previous_tree;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        previous_tree = tree_;
+        tree_ = tree;
+    }
+
+    std::vector<PathChange> changes;
+    Parser2::diffYAML(( previous_tree ) ? previous_tree->root() : FrozenNode(),
+                      ( tree ) ? tree->root() : FrozenNode(), changes);
+    notify(changes);
+}
+
+void ChangeNotifier::notify(const std::vector<PathChange>& changes) const
+{
+    if ( changes.empty() )
+    {
+        return;
+    }
+
+    /* collect first, so that callbacks may (un)subscribe */
+    std::vector<std::pair<Callback, std::vector<PathChange>>> calls;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for ( const Subscription& subscription : subscriptions_ )
+        {
+            std::vector<PathChange> relevant_changes;
+            for ( const PathChange& change : changes )
+            {
+                if ( isAffected(subscription.prefix, change.path) )
+                {
+                    relevant_changes.push_back(change);
+                }
+            }
+            if ( !relevant_changes.empty() )
+            {
+                calls.emplace_back(subscription.callback, std::move(relevant_changes));
+            }
+        }
+    }
+
+    for ( const auto& call : calls )
+    {
+        call.first(call.second);
+    }
+}
+
+std::shared_ptr<const FrozenTree> ChangeNotifier::current() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tree_;
+}
+
+} // namespace yaml_common
+} // namespace kelo
@@ -0,0 +1,337 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <map>
+#include <set>
+
+#include <yaml_common/ConfigWatcher.h>
+#include <yaml_common/FileCache.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // __linux__
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/* longest time the background thread waits before checking `is_running_` */
+static const int WAIT_MS = 100;
+
+#ifdef __linux__
+
+/**
+ * @brief Inotify watches on the directories of the watched files
+ */
+class ConfigWatcher::FileWatch
+{
+    public:
+
+        explicit FileWatch(const std::vector<std::string>& abs_file_paths):
+            fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+        {
+            if ( fd_ < 0 )
+            {
+                return;
+            }
+            std::map<std::string, int> directories;
+            for ( const std::string& path : abs_file_paths )
+            {
+                const size_t separator = path.find_last_of('/');
+                const std::string directory = ( separator == std::string::npos )
+                                              ? "." : path.substr(0, separator + 1);
+                auto it = directories.find(directory);
+                if ( it == directories.end() )
+                {
+                    const int wd = inotify_add_watch(fd_, directory.c_str(),
+                                                     IN_CLOSE_WRITE | IN_MOVED_TO);
+                    it = directories.emplace(directory, wd).first;
+                }
+                names_[it->second].insert(path.substr(separator + 1));
+            }
+        }
+
+        ~FileWatch()
+        {
+            if ( fd_ >= 0 )
+            {
+                ::close(fd_);
+            }
+        }
+
+        bool isValid() const
+        {
+            return ( fd_ >= 0 && names_.count(-1) == 0 );
+        }
+
+        /**
+         * @brief Wait up to `timeout_ms` for a watched file to be written or
+         * replaced
+         */
+        bool wait(int timeout_ms)
+        {
+            pollfd poll_fd{fd_, POLLIN, 0};
+            if ( ::poll(&poll_fd, 1, timeout_ms) <= 0 )
+            {
+                return false;
+            }
+
+            bool is_changed = false;
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while ( ( length = ::read(fd_, buffer, sizeof(buffer)) ) > 0 )
+            {
+                for ( ssize_t offset = 0; offset < length; )
+                {
+                    const inotify_event* event =
+                        reinterpret_cast<const inotify_event*>(buffer + offset);
+                    auto it = names_.find(event->wd);
+                    if ( event->len > 0 && it != names_.end() &&
+                         it->second.count(event->name) > 0 )
+                    {
+                        is_changed = true;
+                    }
+                    offset += sizeof(inotify_event) + event->len;
+                }
+            }
+            return is_changed;
+        }
+
+    private:
+
+        int fd_;
+        /* names of the watched files per watched directory */
+        std::map<int, std::set<std::string>> names_;
+
+};
+
+#else
+
+/**
+ * @brief Polls the modification time and size of the watched files
+ */
+class ConfigWatcher::FileWatch
+{
+    public:
+
+        explicit FileWatch(const std::vector<std::string>& abs_file_paths):
+            abs_file_paths_(abs_file_paths)
+        {
+            for ( const std::string& path : abs_file_paths_ )
+            {
+                keys_.push_back(FileCache::makeKey(path));
+            }
+        }
+
+        bool isValid() const
+        {
+            return true;
+        }
+
+        bool wait(int timeout_ms)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+            bool is_changed = false;
+            for ( size_t i = 0; i < abs_file_paths_.size(); i++ )
+            {
+                FileCache::Key key = FileCache::makeKey(abs_file_paths_[i]);
+                if ( !( key == keys_[i] ) )
+                {
+                    keys_[i] = std::move(key);
+                    is_changed = true;
+                }
+            }
+            return is_changed;
+        }
+
+    private:
+
+        std::vector<std::string> abs_file_paths_;
+        std::vector<FileCache::Key> keys_;
+
+};
+
+#endif // __linux__
+
+ConfigWatcher::ConfigWatcher(const std::string& abs_file_path,
+                             ErrorSink* error_sink):
+    ConfigWatcher(std::vector<std::string>(1, abs_file_path), error_sink)
+{
+}
+
+ConfigWatcher::ConfigWatcher(const std::vector<std::string>& abs_file_paths,
+                             ErrorSink* error_sink):
+    abs_file_paths_(abs_file_paths),
+    error_sink_(error_sink),
+    published_(new Version())
+{
+    num_of_readers_[0] = 0;
+    num_of_readers_[1] = 0;
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    stop();
+    delete published_.load();
+}
+
+void ConfigWatcher::setCallback(const Callback& callback)
+{
+    callback_ = callback;
+}
+
+bool ConfigWatcher::start()
+{
+    if ( is_running_ )
+    {
+        return false;
+    }
+
+    /* watch before loading so that no change in between is missed */
+    std::unique_ptr<FileWatch> file_watch(new FileWatch(abs_file_paths_));
+    if ( !file_watch->isValid() )
+    {
+        if ( error_sink_ != nullptr )
+        {
+            const std::string detail("Could not watch config files");
+            error_sink_->report(Error(ErrorCode::OTHER, detail));
+        }
+        return false;
+    }
+    if ( !reload() )
+    {
+        return false;
+    }
+
+    file_watch_ = std::move(file_watch);
+    is_running_ = true;
+    thread_ = std::thread(&ConfigWatcher::watch, this);
+    return true;
+}
+
+void ConfigWatcher::stop()
+{
+    is_running_ = false;
+    if ( thread_.joinable() )
+    {
+        thread_.join();
+    }
+    file_watch_.reset();
+}
+
+void ConfigWatcher::watch()
+{
+    while ( is_running_ )
+    {
+        if ( !file_watch_->wait(WAIT_MS) )
+        {
+            continue;
+        }
+        /* collect the rest of a burst of writes */
+        while ( is_running_ && file_watch_->wait(DEBOUNCE_MS) )
+        {
+        }
+        if ( is_running_ )
+        {
+            reload();
+        }
+    }
+}
+
+bool ConfigWatcher::reload()
+{
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+
+    std::vector<YAML::Node> layers(abs_file_paths_.size());
+    for ( size_t i = 0; i < abs_file_paths_.size(); i++ )
+    {
+        if ( !Parser2::loadFile(abs_file_paths_[i], layers[i], error_sink_) )
+        {
+            return false;
+        }
+    }
+    const YAML::Node node = ( layers.size() == 1 ) ? layers[0]
+                                                   : Parser2::mergeLayers(layers);
+    const std::shared_ptr<const FrozenTree> tree =
+        std::make_shared<const FrozenTree>(node);
+    publish(tree);
+    if ( callback_ )
+    {
+        callback_(tree);
+    }
+    return true;
+}
+
+void ConfigWatcher::publish(const std::shared_ptr<const FrozenTree>& tree)
+{
+    Version* old_version = published_.exchange(new Version{tree});
+    version_++;
+
+    /* readers still copying the tree out of `old_version` registered before
+     * the exchange, in the slot of whichever epoch they read, so both slots
+     * have to be empty once. Moving to the next epoch before waiting on a
+     * slot sends new readers to the other one, so they cannot keep it busy;
+     * readers registering in a slot that is waited on see the new Version */
+    for ( size_t i = 0; i < 2; i++ )
+    {
+        const uint64_t epoch = epoch_.fetch_add(1);
+        while ( num_of_readers_[epoch % 2].load() != 0 )
+        {
+            std::this_thread::yield();
+        }
+    }
+    delete old_version;
+}
+
+std::shared_ptr<const FrozenTree> ConfigWatcher::current() const
+{
+    const uint64_t epoch = epoch_.load();
+    num_of_readers_[epoch % 2]++;
+    std::shared_ptr<const FrozenTree> tree = published_.load()->tree;
+    num_of_readers_[epoch % 2]--;
+    return tree;
+}
+
+} // namespace yaml_common
+} // namespace kelo
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <yaml_common/ErrorSink.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+std::string Error::message() const
+{
+    switch ( code_ )
+    {
+        case ErrorCode::EMPTY_KEY:
+            return "Given key is empty";
+        case ErrorCode::NOT_A_MAP:
+            return "Given YAML::Node is not a map";
+        case ErrorCode::MISSING_KEY:
+            return "Given YAML::Node does not have key " + *detail_;
+        case ErrorCode::BAD_VALUE:
+            return "Could not read value of YAML::Node";
+        case ErrorCode::BAD_VALUE_FOR_KEY:
+            return "Could not read YAML::Node with key " + *detail_;
+        case ErrorCode::NON_SCALAR_KEY:
+            return "Given YAML::Node map contains a non-scalar key";
+        case ErrorCode::BAD_FILE:
+            return "YAML threw BadFile exception. Does the file exist?\n" + *detail_;
+        case ErrorCode::PARSE_ERROR:
+            return "YAML parsing error\n" + *detail_;
+        case ErrorCode::OTHER:
+        default:
+            return *detail_;
+    }
+}
+
+void ConsoleErrorSink::report(const Error& error)
+{
+    const std::string msg = error.message();
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_ << "\033[31m" // change terminal color to red
+         << "[Parser2] "
+         << msg
+         << "\033[0m" // restore terminal color
+         << "\n";
+}
+
+void CallbackErrorSink::report(const Error& error)
+{
+    if ( callback_ )
+    {
+        callback_(error);
+    }
+}
+
+void BufferedErrorSink::report(const Error& error)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.push_back(Record{error.code(), error.detail()});
+}
+
+size_t BufferedErrorSink::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_.size();
+}
+
+std::vector<ErrorCode> BufferedErrorSink::codes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ErrorCode> codes;
+    codes.reserve(records_.size());
+    for ( const Record& record : records_ )
+    {
+        codes.push_back(record.code);
+    }
+    return codes;
+}
+
+std::vector<std::string> BufferedErrorSink::messages() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> messages;
+    messages.reserve(records_.size());
+    for ( const Record& record : records_ )
+    {
+        messages.push_back(Error(record.code, record.detail).message());
+    }
+    return messages;
+}
+
+void BufferedErrorSink::flush(std::ostream& out)
+{
+    std::vector<Record> records;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records.swap(records_);
+    }
+    for ( const Record& record : records )
+    {
+        out << "[Parser2] " << Error(record.code, record.detail).message() << "\n";
+    }
+    out.flush();
+}
+
+void BufferedErrorSink::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+}
+
+} // namespace yaml_common
+} // namespace kelo
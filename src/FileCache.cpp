@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cstdlib>
+#include <sys/stat.h>
+#include <yaml_common/FileCache.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+FileCache::Key FileCache::makeKey(const std::string& file_path)
+{
+    Key key;
+#ifdef _WIN32
+    char* canonical_path = _fullpath(nullptr, file_path.c_str(), 0);
+    struct _stat64 file_stat;
+    const bool is_stat_valid = ( canonical_path &&
+                                 _stat64(canonical_path, &file_stat) == 0 );
+#else
+    char* canonical_path = ::realpath(file_path.c_str(), nullptr);
+    struct stat file_stat;
+    const bool is_stat_valid = ( canonical_path &&
+                                 ::stat(canonical_path, &file_stat) == 0 );
+#endif // _WIN32
+    if ( is_stat_valid )
+    {
+        key.canonical_path = canonical_path;
+#ifdef _WIN32
+        key.mtime_ns = static_cast<int64_t>(file_stat.st_mtime) * 1000000000;
+#else
+        key.mtime_ns = static_cast<int64_t>(file_stat.st_mtim.tv_sec) * 1000000000
+                       + file_stat.st_mtim.tv_nsec;
+#endif // _WIN32
+        key.size = static_cast<uint64_t>(file_stat.st_size);
+    }
+    std::free(canonical_path);
+    return key;
+}
+
+std::shared_ptr<const FrozenTree> FileCache::find(const Key& key)
+{
+    if ( key.isValid() )
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key.canonical_path);
+        if ( it != entries_.end() &&
+             it->second.mtime_ns == key.mtime_ns &&
+             it->second.size == key.size )
+        {
+            num_of_hits_++;
+            return it->second.tree;
+        }
+    }
+    num_of_misses_++;
+    return nullptr;
+}
+
+void FileCache::insert(const Key& key, const std::shared_ptr<const FrozenTree>& tree)
+{
+    if ( !key.isValid() || !tree )
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key.canonical_path);
+    if ( it == entries_.end() )
+    {
+        entries_.emplace(key.canonical_path, Entry{key.mtime_ns, key.size, tree});
+        return;
+    }
+    it->second.mtime_ns = key.mtime_ns;
+    it->second.size = key.size;
+    it->second.tree = tree;
+}
+
+bool FileCache::invalidate(const std::string& file_path)
+{
+    const Key key = FileCache::makeKey(file_path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.erase(( key.isValid() ) ? key.canonical_path : file_path) > 0;
+}
+
+void FileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t FileCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace yaml_common
+} // namespace kelo
@@ -0,0 +1,489 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+static uint64_t combineHash(uint64_t seed, uint64_t value)
+{
+    return seed ^ ( value + 0x9e3779b97f4a7c15ULL + ( seed << 6 ) + ( seed >> 2 ) );
+}
+
+FrozenTree::FrozenTree(const YAML::Node& node):
+    strings_(1)
+{
+    elements_.push_back(Element{YAML::NodeType::Undefined, YAML::EmitterStyle::Default,
+                                0, 0, 0, 0, 0, 0, 0});
+    freeze(node, 0);
+}
+
+uint32_t FrozenTree::addString(const std::string& str)
+{
+    if ( str.empty() )
+    {
+        return 0;
+    }
+    strings_.push_back(str);
+    return static_cast<uint32_t>(strings_.size() - 1);
+}
+
+void FrozenTree::freeze(const YAML::Node& node, uint32_t index)
+{
+    if ( elements_.size() >= std::numeric_limits<uint32_t>::max() / 2 )
+    {
+        throw std::length_error("FrozenTree: too many nodes");
+    }
+
+    const YAML::NodeType::value type = ( node.IsDefined() ) ? node.Type()
+                                                            : YAML::NodeType::Undefined;
+    elements_[index] = Element{type, YAML::EmitterStyle::Default, 0, 0, 0, 0, 0, 0,
+                                combineHash(0, type)};
+    if ( type == YAML::NodeType::Undefined )
+    {
+        return;
+    }
+    elements_[index].style = node.Style();
+    elements_[index].tag = addString(node.Tag());
+    uint64_t hash = combineHash(elements_[index].hash,
+                                std::hash<std::string>()(node.Tag()));
+
+    if ( type == YAML::NodeType::Scalar )
+    {
+        elements_[index].scalar = addString(node.Scalar());
+        hash = combineHash(hash, std::hash<std::string>()(node.Scalar()));
+    }
+    else if ( type == YAML::NodeType::Sequence || type == YAML::NodeType::Map )
+    {
+        /* children are reserved as one block before descending, so that
+         * they stay contiguous; `elements_` may grow during the recursion,
+         * hence no references into it are kept */
+        const bool is_map = ( type == YAML::NodeType::Map );
+        const uint32_t first = static_cast<uint32_t>(elements_.size());
+        const uint32_t size = static_cast<uint32_t>(node.size());
+        elements_.resize(first + ( ( is_map ) ? 2 * size : size ));
+        elements_[index].first = first;
+        elements_[index].size = size;
+
+        uint32_t child = first;
+        for ( const auto& entry : node )
+        {
+            if ( is_map )
+            {
+                freeze(entry.first, child++);
+                freeze(entry.second, child++);
+            }
+            else
+            {
+                freeze(entry, child++);
+            }
+        }
+        for ( child = first; child < first + ( ( is_map ) ? 2 * size : size ); child++ )
+        {
+            hash = combineHash(hash, elements_[child].hash);
+        }
+        if ( is_map && size > LINEAR_FIND_MAX_SIZE )
+        {
+            this->index(index);
+        }
+    }
+    elements_[index].hash = hash;
+}
+
+void FrozenTree::index(uint32_t index)
+{
+    const Element& map = elements_[index];
+    const uint32_t begin = static_cast<uint32_t>(sorted_entries_.size());
+    for ( uint32_t entry = 0; entry < map.size; entry++ )
+    {
+        if ( elements_[map.first + 2 * entry].type == YAML::NodeType::Scalar )
+        {
+            sorted_entries_.push_back(entry);
+        }
+    }
+
+    /* stable, so that the first of duplicate keys is found first */
+    std::stable_sort(sorted_entries_.begin() + begin, sorted_entries_.end(),
+            [this, &map](uint32_t a, uint32_t b)
+            {
+                return strings_[elements_[map.first + 2 * a].scalar] <
+                       strings_[elements_[map.first + 2 * b].scalar];
+            });
+    elements_[index].sorted_begin = begin;
+    elements_[index].sorted_end = static_cast<uint32_t>(sorted_entries_.size());
+}
+
+const std::string& FrozenNode::emptyString()
+{
+    static const std::string empty;
+    return empty;
+}
+
+size_t FrozenNode::size() const
+{
+    return ( tree_ == nullptr ) ? 0 : tree_->elements_[index_].size;
+}
+
+uint64_t FrozenNode::hash() const
+{
+    return ( tree_ == nullptr ) ? 0 : tree_->elements_[index_].hash;
+}
+
+const std::string& FrozenNode::tag() const
+{
+    return ( tree_ == nullptr ) ? FrozenNode::emptyString()
+                                : tree_->strings_[tree_->elements_[index_].tag];
+}
+
+FrozenNode FrozenNode::operator [] (size_t index) const
+{
+    if ( !isSequence() || index >= size() )
+    {
+        return FrozenNode();
+    }
+    return FrozenNode(tree_, tree_->elements_[index_].first + index);
+}
+
+FrozenNode FrozenNode::key(size_t entry) const
+{
+    if ( !isMap() || entry >= size() )
+    {
+        return FrozenNode();
+    }
+    return FrozenNode(tree_, tree_->elements_[index_].first + 2 * entry);
+}
+
+FrozenNode FrozenNode::value(size_t entry) const
+{
+    if ( !isMap() || entry >= size() )
+    {
+        return FrozenNode();
+    }
+    return FrozenNode(tree_, tree_->elements_[index_].first + 2 * entry + 1);
+}
+
+FrozenNode FrozenNode::find(const std::string& key) const
+{
+    if ( !isMap() )
+    {
+        return FrozenNode();
+    }
+
+    const FrozenTree::Element& map = tree_->elements_[index_];
+    const std::vector<FrozenTree::Element>& elements = tree_->elements_;
+    const std::vector<std::string>& strings = tree_->strings_;
+    if ( map.size <= FrozenTree::LINEAR_FIND_MAX_SIZE )
+    {
+        for ( uint32_t key_index = map.first; key_index < map.first + 2 * map.size;
+              key_index += 2 )
+        {
+            if ( elements[key_index].type == YAML::NodeType::Scalar &&
+                 strings[elements[key_index].scalar] == key )
+            {
+                return FrozenNode(tree_, key_index + 1);
+            }
+        }
+        return FrozenNode();
+    }
+
+    const auto begin = tree_->sorted_entries_.begin() + map.sorted_begin;
+    const auto end = tree_->sorted_entries_.begin() + map.sorted_end;
+    const auto it = std::lower_bound(begin, end, key,
+            [&](uint32_t entry, const std::string& k)
+            {
+                return strings[elements[map.first + 2 * entry].scalar] < k;
+            });
+    if ( it == end || strings[elements[map.first + 2 * *it].scalar] != key )
+    {
+        return FrozenNode();
+    }
+    return FrozenNode(tree_, map.first + 2 * *it + 1);
+}
+
+YAML::Node FrozenNode::thaw() const
+{
+    YAML::Node node;
+    switch ( type() )
+    {
+        case YAML::NodeType::Undefined:
+            /* same as the value of a missing key of a const node */
+            return YAML::Node(YAML::NodeType::Undefined);
+        case YAML::NodeType::Null:
+            node.reset(YAML::Node(YAML::NodeType::Null));
+            break;
+        case YAML::NodeType::Scalar:
+            node.reset(YAML::Node(scalar()));
+            break;
+        case YAML::NodeType::Sequence:
+            node.reset(YAML::Node(YAML::NodeType::Sequence));
+            for ( size_t i = 0; i < size(); i++ )
+            {
+                node.push_back((*this)[i].thaw());
+            }
+            break;
+        case YAML::NodeType::Map:
+            node.reset(YAML::Node(YAML::NodeType::Map));
+            for ( size_t i = 0; i < size(); i++ )
+            {
+                node.force_insert(key(i).thaw(), value(i).thaw());
+            }
+            break;
+    }
+    if ( !tag().empty() )
+    {
+        node.SetTag(tag());
+    }
+    node.SetStyle(tree_->elements_[index_].style);
+    return node;
+}
+
+/**
+ * @brief Append `key` to the key path in `path`; shrink `path` back to its
+ * returned length afterwards
+ */
+static size_t appendKeyPath(std::string& path, const std::string& key)
+{
+    const size_t length = path.size();
+    if ( length > 0 )
+    {
+        path += '/';
+    }
+    path += key;
+    return length;
+}
+
+static bool hasOnlyScalarKeys(const FrozenNode& map)
+{
+    for ( size_t i = 0; i < map.size(); i++ )
+    {
+        if ( !map.key(i).isScalar() )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Whether entry `entry` of `map` holds the first occurrence of its key
+ */
+static bool isFirstOccurrence(const FrozenNode& map, size_t entry)
+{
+    return map.find(map.key(entry).scalar()).is(map.value(entry));
+}
+
+static void diffNodes(const FrozenNode& old_node, const FrozenNode& new_node,
+                      std::string& path, std::vector<PathChange>& changes);
+
+static void diffMaps(const FrozenNode& old_node, const FrozenNode& new_node,
+                     std::string& path, std::vector<PathChange>& changes)
+{
+    for ( size_t i = 0; i < old_node.size(); i++ )
+    {
+        if ( !isFirstOccurrence(old_node, i) )
+        {
+            continue;
+        }
+        const std::string& key = old_node.key(i).scalar();
+        const size_t length = appendKeyPath(path, key);
+        const FrozenNode new_value = new_node.find(key);
+        if ( new_value.isDefined() )
+        {
+            diffNodes(old_node.value(i), new_value, path, changes);
+        }
+        else
+        {
+            changes.push_back(PathChange{ChangeType::REMOVED, path});
+        }
+        path.resize(length);
+    }
+
+    for ( size_t i = 0; i < new_node.size(); i++ )
+    {
+        const std::string& key = new_node.key(i).scalar();
+        if ( isFirstOccurrence(new_node, i) && !old_node.find(key).isDefined() )
+        {
+            const size_t length = appendKeyPath(path, key);
+            changes.push_back(PathChange{ChangeType::ADDED, path});
+            path.resize(length);
+        }
+    }
+}
+
+static void diffSequences(const FrozenNode& old_node, const FrozenNode& new_node,
+                          std::string& path, std::vector<PathChange>& changes)
+{
+    for ( size_t i = 0; i < std::max(old_node.size(), new_node.size()); i++ )
+    {
+        const FrozenNode old_element = old_node[i];
+        const FrozenNode new_element = new_node[i];
+        if ( old_element.isDefined() && new_element.isDefined() &&
+             old_element.hash() == new_element.hash() )
+        {
+            continue;
+        }
+        const size_t length = appendKeyPath(path, std::to_string(i));
+        if ( !new_element.isDefined() )
+        {
+            changes.push_back(PathChange{ChangeType::REMOVED, path});
+        }
+        else if ( !old_element.isDefined() )
+        {
+            changes.push_back(PathChange{ChangeType::ADDED, path});
+        }
+        else
+        {
+            diffNodes(old_element, new_element, path, changes);
+        }
+        path.resize(length);
+    }
+}
+
+static void diffNodes(const FrozenNode& old_node, const FrozenNode& new_node,
+                      std::string& path, std::vector<PathChange>& changes)
+{
+    /* hashes cover the whole subtree, so equal subtrees are never entered */
+    if ( old_node.is(new_node) || old_node.hash() == new_node.hash() )
+    {
+        return;
+    }
+    if ( old_node.isMap() && new_node.isMap() && old_node.tag() == new_node.tag() &&
+         hasOnlyScalarKeys(old_node) && hasOnlyScalarKeys(new_node) )
+    {
+        diffMaps(old_node, new_node, path, changes);
+    }
+    else if ( old_node.isSequence() && new_node.isSequence() &&
+              old_node.tag() == new_node.tag() )
+    {
+        diffSequences(old_node, new_node, path, changes);
+    }
+    else
+    {
+        changes.push_back(PathChange{ChangeType::CHANGED, path});
+    }
+}
+
+void Parser2::diffYAML(const FrozenNode& old_node, const FrozenNode& new_node,
+                       std::vector<PathChange>& changes)
+{
+    std::string path;
+    if ( !old_node.isDefined() || !new_node.isDefined() )
+    {
+        if ( old_node.isDefined() != new_node.isDefined() )
+        {
+            changes.push_back(PathChange{( new_node.isDefined() ) ? ChangeType::ADDED
+                                                                  : ChangeType::REMOVED,
+                                         path});
+        }
+        return;
+    }
+    diffNodes(old_node, new_node, path, changes);
+}
+
+bool Parser2::find(const FrozenNode& node, const std::string& key,
+                   FrozenNode& child, bool print_error_msg)
+{
+    return Parser2::find(node, key, child, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::find(const FrozenNode& node, const std::string& key,
+                   FrozenNode& child, ErrorSink* error_sink)
+{
+    if ( key.empty() )
+    {
+        Parser2::report(error_sink, ErrorCode::EMPTY_KEY);
+        return false;
+    }
+
+    if ( !node.isMap() )
+    {
+        Parser2::report(error_sink, ErrorCode::NOT_A_MAP);
+        return false;
+    }
+
+    const FrozenNode value = node.find(key);
+    if ( !value.isDefined() )
+    {
+        Parser2::report(error_sink, ErrorCode::MISSING_KEY, key);
+        return false;
+    }
+
+    child = value;
+    return true;
+}
+
+bool Parser2::hasKey(const FrozenNode& node, const std::string& key,
+                     bool print_error_msg)
+{
+    return Parser2::hasKey(node, key, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::hasKey(const FrozenNode& node, const std::string& key,
+                     ErrorSink* error_sink)
+{
+    FrozenNode child;
+    return Parser2::find(node, key, child, error_sink);
+}
+
+bool Parser2::readAllKeys(const FrozenNode& node, std::vector<std::string>& keys,
+                          bool print_error_msg)
+{
+    return Parser2::readAllKeys(node, keys, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::readAllKeys(const FrozenNode& node, std::vector<std::string>& keys,
+                          ErrorSink* error_sink)
+{
+    keys.reserve(keys.size() + node.size());
+    return Parser2::forEachKey(node, [&keys](const std::string& key)
+                               { keys.push_back(key); }, error_sink);
+}
+
+} // namespace yaml_common
+} // namespace kelo
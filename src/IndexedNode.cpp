@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <yaml_common/IndexedNode.h>
+#include <yaml_common/Parser2.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+IndexedNode::IndexedNode(const YAML::Node& node):
+    node_(node)
+{
+    refresh();
+}
+
+size_t IndexedNode::size() const
+{
+    return ( node_.IsMap() ) ? node_.size() : 0;
+}
+
+void IndexedNode::refresh() const
+{
+    index_.clear();
+    ordered_keys_.clear();
+    has_non_scalar_key_ = false;
+    indexed_size_ = size();
+    if ( indexed_size_ == 0 )
+    {
+        return;
+    }
+
+    index_.reserve(indexed_size_);
+    ordered_keys_.reserve(indexed_size_);
+    for ( YAML::const_iterator it = node_.begin(); it != node_.end(); ++it )
+    {
+        if ( !it->first.IsScalar() )
+        {
+            has_non_scalar_key_ = true;
+            continue;
+        }
+        /* for duplicate keys the first one wins, like in `node[key]` */
+        auto result = index_.emplace(it->first.Scalar(), it->second);
+        ordered_keys_.push_back(&result.first->first);
+    }
+}
+
+void IndexedNode::refreshIfStale() const
+{
+    if ( size() != indexed_size_ )
+    {
+        refresh();
+    }
+}
+
+bool IndexedNode::lookup(const std::string& key, YAML::Node& child) const
+{
+    refreshIfStale();
+    auto it = index_.find(key);
+    if ( it == index_.end() )
+    {
+        return false;
+    }
+    child.reset(it->second);
+    return true;
+}
+
+bool IndexedNode::keys(std::vector<std::string>& keys) const
+{
+    refreshIfStale();
+    if ( has_non_scalar_key_ )
+    {
+        return false;
+    }
+    keys.reserve(keys.size() + ordered_keys_.size());
+    for ( const std::string* key : ordered_keys_ )
+    {
+        keys.push_back(*key);
+    }
+    return true;
+}
+
+bool Parser2::find(const IndexedNode& node, const std::string& key,
+                   YAML::Node& child, bool print_error_msg)
+{
+    return Parser2::find(node, key, child, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::find(const IndexedNode& node, const std::string& key,
+                   YAML::Node& child, ErrorSink* error_sink)
+{
+    if ( key.empty() )
+    {
+        Parser2::report(error_sink, ErrorCode::EMPTY_KEY);
+        return false;
+    }
+
+    if ( !node.node().IsMap() )
+    {
+        Parser2::report(error_sink, ErrorCode::NOT_A_MAP);
+        return false;
+    }
+
+    if ( !node.lookup(key, child) )
+    {
+        Parser2::report(error_sink, ErrorCode::MISSING_KEY, key);
+        return false;
+    }
+    return true;
+}
+
+bool Parser2::hasKey(const IndexedNode& node, const std::string& key,
+                     bool print_error_msg)
+{
+    return Parser2::hasKey(node, key, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::hasKey(const IndexedNode& node, const std::string& key,
+                     ErrorSink* error_sink)
+{
+    YAML::Node child;
+    return Parser2::find(node, key, child, error_sink);
+}
+
+bool Parser2::readAllKeys(const IndexedNode& node, std::vector<std::string>& keys,
+                          bool print_error_msg)
+{
+    return Parser2::readAllKeys(node, keys, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::readAllKeys(const IndexedNode& node, std::vector<std::string>& keys,
+                          ErrorSink* error_sink)
+{
+    if ( !node.node().IsMap() )
+    {
+        Parser2::report(error_sink, ErrorCode::NOT_A_MAP);
+        return false;
+    }
+
+    if ( !node.keys(keys) )
+    {
+        Parser2::report(error_sink, ErrorCode::NON_SCALAR_KEY);
+        return false;
+    }
+    return true;
+}
+
+} // namespace yaml_common
+} // namespace kelo
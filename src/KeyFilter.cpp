@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <yaml_common/KeyFilter.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+KeyFilter::KeyFilter():
+    nodes_(1, PatternNode{{}, {}, 0, false})
+{
+}
+
+KeyFilter& KeyFilter::addKey(const std::string& key)
+{
+    keys_.insert(key);
+    return *this;
+}
+
+KeyFilter& KeyFilter::addPath(const std::string& pattern)
+{
+    std::vector<std::string> segments;
+    size_t start = 0;
+    for ( size_t i = 0; i <= pattern.size(); i++ )
+    {
+        if ( i == pattern.size() || pattern[i] == '/' )
+        {
+            segments.push_back(pattern.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+    return addPath(segments);
+}
+
+KeyFilter& KeyFilter::addPath(const std::vector<std::string>& segments)
+{
+    return addSegments(segments, false);
+}
+
+KeyFilter& KeyFilter::addLiteralPath(const std::vector<std::string>& segments)
+{
+    return addSegments(segments, true);
+}
+
+KeyFilter& KeyFilter::addSegments(const std::vector<std::string>& segments,
+                                  bool is_literal)
+{
+    if ( segments.empty() )
+    {
+        return *this;
+    }
+    size_t node = 0;
+    for ( const std::string& segment : segments )
+    {
+        node = addSegment(node, segment, is_literal);
+    }
+    nodes_[node].is_end = true;
+    return *this;
+}
+
+size_t KeyFilter::addSegment(size_t parent, const std::string& segment,
+                             bool is_literal)
+{
+    const bool is_wildcard = ( !is_literal && segment == "*" );
+
+    if ( is_wildcard )
+    {
+        /* 0 is the root and never a child, so it marks a missing child */
+        if ( nodes_[parent].wildcard == 0 )
+        {
+            nodes_[parent].wildcard = nodes_.size();
+            nodes_.push_back(PatternNode{{}, {}, 0, false});
+        }
+        return nodes_[parent].wildcard;
+    }
+
+    std::unordered_map<std::string, size_t>& children = ( is_literal )
+                                                        ? nodes_[parent].key_children
+                                                        : nodes_[parent].children;
+    auto it = children.find(segment);
+    if ( it != children.end() )
+    {
+        return it->second;
+    }
+
+    const size_t child = nodes_.size();
+    /* may reallocate nodes_, so `children` is not used afterwards */
+    nodes_.push_back(PatternNode{{}, {}, 0, false});
+    ( ( is_literal ) ? nodes_[parent].key_children
+                     : nodes_[parent].children ).emplace(segment, child);
+    return child;
+}
+
+bool KeyFilter::empty() const
+{
+    return keys_.empty() && nodes_.size() == 1;
+}
+
+KeyFilter::Position KeyFilter::root() const
+{
+    return ( nodes_.size() > 1 ) ? Position(1, 0) : Position();
+}
+
+bool KeyFilter::skip(const Position& position, const std::string& key,
+                     Position& next) const
+{
+    if ( !keys_.empty() && keys_.count(key) > 0 )
+    {
+        return true;
+    }
+    return stepPattern(position, &key, false, next);
+}
+
+bool KeyFilter::skip(const Position& position, size_t index, Position& next) const
+{
+    /* indices are only converted when some pattern names one explicitly */
+    for ( size_t node : position )
+    {
+        if ( !nodes_[node].children.empty() )
+        {
+            const std::string key = std::to_string(index);
+            return stepPattern(position, &key, true, next);
+        }
+    }
+    return stepPattern(position, nullptr, true, next);
+}
+
+bool KeyFilter::stepPattern(const Position& position, const std::string* key,
+                            bool is_index, Position& next) const
+{
+    next.clear();
+    for ( size_t node : position )
+    {
+        const PatternNode& pattern_node = nodes_[node];
+        if ( key != nullptr && !pattern_node.children.empty() )
+        {
+            auto it = pattern_node.children.find(*key);
+            if ( it != pattern_node.children.end() && advance(it->second, next) )
+            {
+                return true;
+            }
+        }
+        if ( key != nullptr && !is_index && !pattern_node.key_children.empty() )
+        {
+            auto it = pattern_node.key_children.find(*key);
+            if ( it != pattern_node.key_children.end() && advance(it->second, next) )
+            {
+                return true;
+            }
+        }
+        if ( pattern_node.wildcard != 0 && advance(pattern_node.wildcard, next) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool KeyFilter::advance(size_t child, Position& next) const
+{
+    if ( nodes_[child].is_end )
+    {
+        return true;
+    }
+    next.push_back(child);
+    return false;
+}
+
+} // namespace yaml_common
+} // namespace kelo
@@ -0,0 +1,602 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <locale.h>
+#include <stdlib.h>
+#include <yaml_common/NumericScalar.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+namespace
+{
+
+/* powers of ten that are exactly representable as double */
+const double exact_double_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/* powers of ten that are exactly representable as float */
+const float exact_float_powers_of_ten[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+/* number of decimal digits that always fit in an uint64_t */
+const int max_mantissa_digits = 19;
+
+bool isSpace(char c)
+{
+    return ( c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' ||
+             c == '\r' );
+}
+
+bool isDigit(char c)
+{
+    return ( c >= '0' && c <= '9' );
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+
+/**
+ * @brief Read 8 decimal digits at once (SWAR: SIMD within a register)
+ *
+ * @param str pointer to at least 8 characters
+ * @param value value of the 8 digits
+ * @return bool false if any of the 8 characters is not a digit
+ */
+bool readEightDigits(const char* str, uint64_t& value)
+{
+    uint64_t chunk;
+    std::memcpy(&chunk, str, sizeof(chunk));
+    /* each byte is a digit iff its high nibble is 3 and adding 6 does not
+     * carry into it */
+    if ( ( ( chunk & 0xF0F0F0F0F0F0F0F0 ) |
+           ( ( ( chunk + 0x0606060606060606 ) & 0xF0F0F0F0F0F0F0F0 ) >> 4 ) ) !=
+         0x3333333333333333 )
+    {
+        return false;
+    }
+    chunk -= 0x3030303030303030;
+    /* combine pairs of digits, then pairs of pairs, then pairs of quads */
+    chunk = ( chunk * 10 ) + ( chunk >> 8 );
+    value = ( ( ( chunk & 0x000000FF000000FF ) * ( 100 + ( 1000000ULL << 32 ) ) ) +
+              ( ( ( chunk >> 16 ) & 0x000000FF000000FF ) * ( 1 + ( 10000ULL << 32 ) ) ) ) >> 32;
+    return true;
+}
+
+#else
+
+bool readEightDigits(const char* /*str*/, uint64_t& /*value*/)
+{
+    return false;
+}
+
+#endif // __BYTE_ORDER__
+
+bool isLower(char c)
+{
+    return ( c >= 'a' && c <= 'z' );
+}
+
+bool isUpper(char c)
+{
+    return ( c >= 'A' && c <= 'Z' );
+}
+
+/**
+ * @brief End of `str` without its trailing whitespace, which
+ * `YAML::convert<T>::decode` skips after a number
+ */
+const char* trimmedEnd(const std::string& str)
+{
+    const char* begin = str.data();
+    const char* end = begin + str.size();
+    while ( end != begin && isSpace(*(end - 1)) )
+    {
+        end--;
+    }
+    return end;
+}
+
+int digitValue(char c, unsigned int base)
+{
+    int digit = -1;
+    if ( isDigit(c) )
+    {
+        digit = c - '0';
+    }
+    else if ( c >= 'a' && c <= 'f' )
+    {
+        digit = c - 'a' + 10;
+    }
+    else if ( c >= 'A' && c <= 'F' )
+    {
+        digit = c - 'A' + 10;
+    }
+    return ( digit >= 0 && static_cast<unsigned int>(digit) < base ) ? digit : -1;
+}
+
+/**
+ * @brief Read an integer as `std::istream` does with `std::ios::basefield`
+ * unset: optional sign, then hexadecimal ("0x" prefix), octal ("0" prefix) or
+ * decimal digits. Fails if anything follows the digits or the magnitude does
+ * not fit in 64 bits.
+ */
+bool readInteger(const char* it, const char* end, bool& is_negative,
+                 uint64_t& magnitude)
+{
+    is_negative = false;
+    if ( it != end && ( *it == '+' || *it == '-' ) )
+    {
+        is_negative = ( *it == '-' );
+        it++;
+    }
+    unsigned int base = 10;
+    bool has_digits = false;
+    if ( it != end && *it == '0' )
+    {
+        base = 8;
+        has_digits = true;
+        it++;
+        if ( it != end && ( *it == 'x' || *it == 'X' ) )
+        {
+            base = 16;
+            has_digits = false;
+            it++;
+        }
+    }
+    magnitude = 0;
+    for ( ; it != end; it++ )
+    {
+        const int digit = digitValue(*it, base);
+        if ( digit < 0 ||
+             magnitude > ( std::numeric_limits<uint64_t>::max() - digit ) / base )
+        {
+            return false;
+        }
+        magnitude = magnitude * base + digit;
+        has_digits = true;
+    }
+    return has_digits;
+}
+
+template <typename T>
+bool parseInteger(const std::string& str, T& value)
+{
+    bool is_negative;
+    uint64_t magnitude;
+    if ( !readInteger(str.data(), trimmedEnd(str), is_negative, magnitude) )
+    {
+        return false;
+    }
+    const uint64_t max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+    if ( !is_negative )
+    {
+        if ( magnitude > max )
+        {
+            return false;
+        }
+        value = static_cast<T>(magnitude);
+        return true;
+    }
+    /* yaml-cpp rejects any leading '-' for unsigned types, even "-0" */
+    if ( !std::numeric_limits<T>::is_signed || magnitude > max + 1 )
+    {
+        return false;
+    }
+    value = ( magnitude == 0 ) ? T(0) : static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
+    return true;
+}
+
+#ifdef _WIN32
+
+_locale_t cLocale()
+{
+    static const _locale_t locale = _create_locale(LC_ALL, "C");
+    return locale;
+}
+
+double strtoC(const char* str, char** end, double /*tag*/)
+{
+    return _strtod_l(str, end, cLocale());
+}
+
+float strtoC(const char* str, char** end, float /*tag*/)
+{
+    return _strtof_l(str, end, cLocale());
+}
+
+#else
+
+locale_t cLocale()
+{
+    static const locale_t locale = newlocale(LC_ALL_MASK, "C", locale_t(0));
+    return locale;
+}
+
+double strtoC(const char* str, char** end, double /*tag*/)
+{
+    return strtod_l(str, end, cLocale());
+}
+
+float strtoC(const char* str, char** end, float /*tag*/)
+{
+    return strtof_l(str, end, cLocale());
+}
+
+#endif // _WIN32
+
+/**
+ * @brief Special floating point values as spelled by YAML (compared to the
+ * untrimmed scalar, as yaml-cpp does)
+ */
+template <typename T>
+bool parseSpecialFloat(const std::string& str, T& value)
+{
+    if ( str == ".inf" || str == ".Inf" || str == ".INF" ||
+         str == "+.inf" || str == "+.Inf" || str == "+.INF" )
+    {
+        value = std::numeric_limits<T>::infinity();
+        return true;
+    }
+    if ( str == "-.inf" || str == "-.Inf" || str == "-.INF" )
+    {
+        value = -std::numeric_limits<T>::infinity();
+        return true;
+    }
+    if ( str == ".nan" || str == ".NaN" || str == ".NAN" )
+    {
+        value = std::numeric_limits<T>::quiet_NaN();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Compute `mantissa * 10^exponent` with a single correctly rounded
+ * multiplication or division in `T`, which is exact if both operands are
+ * exactly representable: `mantissa` <= 2^53 and |`exponent`| <= 22 for
+ * double, `mantissa` <= 2^24 and |`exponent`| <= 10 for float. Rounding in
+ * double first and then to float would round twice.
+ *
+ * @return bool false if the operands are not exact
+ */
+bool computeExact(uint64_t mantissa, int exponent, double& value)
+{
+    if ( mantissa > ( uint64_t(1) << 53 ) || exponent < -22 || exponent > 22 )
+    {
+        return false;
+    }
+    value = static_cast<double>(mantissa);
+    if ( exponent < 0 )
+    {
+        value /= exact_double_powers_of_ten[-exponent];
+    }
+    else
+    {
+        value *= exact_double_powers_of_ten[exponent];
+    }
+    return true;
+}
+
+bool computeExact(uint64_t mantissa, int exponent, float& value)
+{
+    if ( mantissa > ( uint64_t(1) << 24 ) || exponent < -10 || exponent > 10 )
+    {
+        return false;
+    }
+    value = static_cast<float>(mantissa);
+    if ( exponent < 0 )
+    {
+        value /= exact_float_powers_of_ten[-exponent];
+    }
+    else
+    {
+        value *= exact_float_powers_of_ten[exponent];
+    }
+    return true;
+}
+
+/**
+ * @brief Read a floating point number with the syntax `std::istream`
+ * accepts: optional sign, digits with at most one decimal point and an
+ * optional exponent with at least one digit.
+ *
+ * Numbers with at most 19 significant digits that `computeExact` can handle
+ * are computed directly; all others are left to `strtod`/`strtof` in the
+ * "C" locale.
+ */
+template <typename T>
+bool parseFloat(const std::string& str, T& value)
+{
+    const char* begin = str.c_str();
+    const char* end = trimmedEnd(str);
+    const char* it = begin;
+    bool is_negative = false;
+    if ( it != end && ( *it == '+' || *it == '-' ) )
+    {
+        is_negative = ( *it == '-' );
+        it++;
+    }
+
+    uint64_t mantissa = 0;
+    int num_of_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    bool is_truncated = false;
+    bool is_fraction = false;
+    uint64_t eight_digits;
+    for ( ; it != end; it++ )
+    {
+        /* bulk of long digit runs, once past leading zeros */
+        while ( ( mantissa != 0 || *it != '0' ) &&
+                num_of_digits + 8 <= max_mantissa_digits && end - it >= 8 &&
+                readEightDigits(it, eight_digits) )
+        {
+            mantissa = mantissa * 100000000 + eight_digits;
+            num_of_digits += 8;
+            exponent -= ( is_fraction ) ? 8 : 0;
+            has_digits = true;
+            it += 8;
+        }
+        if ( it == end )
+        {
+            break;
+        }
+        if ( *it == '.' && !is_fraction )
+        {
+            is_fraction = true;
+            continue;
+        }
+        if ( !isDigit(*it) )
+        {
+            break;
+        }
+        has_digits = true;
+        const int digit = *it - '0';
+        if ( mantissa == 0 && digit == 0 )
+        {
+            exponent -= ( is_fraction ) ? 1 : 0; // leading zero
+        }
+        else if ( num_of_digits < max_mantissa_digits )
+        {
+            mantissa = mantissa * 10 + digit;
+            num_of_digits++;
+            exponent -= ( is_fraction ) ? 1 : 0;
+        }
+        else
+        {
+            is_truncated = true;
+            exponent += ( is_fraction ) ? 0 : 1;
+        }
+    }
+    if ( !has_digits )
+    {
+        return parseSpecialFloat(str, value);
+    }
+
+    if ( it != end && ( *it == 'e' || *it == 'E' ) )
+    {
+        it++;
+        bool is_exponent_negative = false;
+        if ( it != end && ( *it == '+' || *it == '-' ) )
+        {
+            is_exponent_negative = ( *it == '-' );
+            it++;
+        }
+        if ( it == end || !isDigit(*it) )
+        {
+            return false;
+        }
+        int explicit_exponent = 0;
+        for ( ; it != end && isDigit(*it); it++ )
+        {
+            /* saturate, the fast path only takes small exponents anyway */
+            if ( explicit_exponent < 100000 )
+            {
+                explicit_exponent = explicit_exponent * 10 + ( *it - '0' );
+            }
+        }
+        exponent += ( is_exponent_negative ) ? -explicit_exponent : explicit_exponent;
+    }
+    if ( it != end )
+    {
+        return false;
+    }
+
+    if ( mantissa == 0 )
+    {
+        value = ( is_negative ) ? -T(0) : T(0);
+        return true;
+    }
+    T exact_result;
+    if ( !is_truncated && computeExact(mantissa, exponent, exact_result) )
+    {
+        value = ( is_negative ) ? -exact_result : exact_result;
+        return true;
+    }
+
+    /* `end` is either the end of `str` or whitespace, where strto* stops */
+    char* parsed_end = nullptr;
+    const T result = strtoC(begin, &parsed_end, T());
+    if ( parsed_end != end ||
+         result == std::numeric_limits<T>::infinity() ||
+         result == -std::numeric_limits<T>::infinity() )
+    {
+        return false; // overflow is rejected by `std::istream` as well
+    }
+    value = result;
+    return true;
+}
+
+} // namespace
+
+bool NumericScalar::parse(const std::string& str, bool& value)
+{
+    /* same spelling rules as `YAML::convert<bool>::decode` */
+    static const char* const true_names[] = {"y", "yes", "true", "on"};
+    static const char* const false_names[] = {"n", "no", "false", "off"};
+    const size_t max_size = 5;
+    if ( str.empty() || str.size() > max_size )
+    {
+        return false;
+    }
+    bool is_all_lower = true;
+    bool is_all_upper = true;
+    for ( size_t i = 1; i < str.size(); i++ )
+    {
+        is_all_lower = is_all_lower && isLower(str[i]);
+        is_all_upper = is_all_upper && isUpper(str[i]);
+    }
+    if ( !( isLower(str[0]) && is_all_lower ) &&
+         !( isUpper(str[0]) && ( is_all_lower || is_all_upper ) ) )
+    {
+        return false;
+    }
+    char lower[max_size + 1] = {};
+    for ( size_t i = 0; i < str.size(); i++ )
+    {
+        lower[i] = ( isUpper(str[i]) ) ? str[i] - 'A' + 'a' : str[i];
+    }
+    for ( size_t i = 0; i < sizeof(true_names) / sizeof(true_names[0]); i++ )
+    {
+        if ( std::string(true_names[i]) == lower )
+        {
+            value = true;
+            return true;
+        }
+        if ( std::string(false_names[i]) == lower )
+        {
+            value = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NumericScalar::parse(const std::string& str, signed char& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, unsigned char& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, short& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, unsigned short& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, int& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, unsigned int& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, long& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, unsigned long& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, long long& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, unsigned long long& value)
+{
+    return parseInteger(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, float& value)
+{
+    return parseFloat(str, value);
+}
+
+bool NumericScalar::parse(const std::string& str, double& value)
+{
+    return parseFloat(str, value);
+}
+
+NumericScalar::Classification NumericScalar::classify(const std::string& str)
+{
+    Classification classification{ScalarType::STRING, 0, 0.0, false};
+    const char first = ( str.empty() ) ? '\0' : str[0];
+    if ( isDigit(first) || first == '+' || first == '-' || first == '.' )
+    {
+        if ( NumericScalar::parse(str, classification.int_value) )
+        {
+            classification.type = ScalarType::INT;
+        }
+        else if ( NumericScalar::parse(str, classification.double_value) )
+        {
+            classification.type = ScalarType::DOUBLE;
+        }
+    }
+    else if ( ( isLower(first) || isUpper(first) ) &&
+              NumericScalar::parse(str, classification.bool_value) )
+    {
+        classification.type = ScalarType::BOOL;
+    }
+    return classification;
+}
+
+} // namespace yaml_common
+} // namespace kelo
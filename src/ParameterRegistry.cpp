@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <yaml_common/ChangeNotifier.h>
+#include <yaml_common/ParameterRegistry.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+/**
+ * @brief Node at the key path given by `segments`; undefined if it is
+ * missing
+ */
+static FrozenNode resolve(const FrozenNode& root, const std::vector<std::string>& segments)
+{
+    FrozenNode node = root;
+    for ( const std::string& segment : segments )
+    {
+        if ( node.isSequence() )
+        {
+            if ( segment.empty() ||
+                 !std::all_of(segment.begin(), segment.end(),
+                              [](char c) { return ( c >= '0' && c <= '9' ); }) )
+            {
+                return FrozenNode();
+            }
+            node = node[std::strtoul(segment.c_str(), nullptr, 10)];
+        }
+        else
+        {
+            node = node.find(segment);
+        }
+        if ( !node.isDefined() )
+        {
+            return node;
+        }
+    }
+    return node;
+}
+
+size_t ParameterRegistry::addBinding(const std::string& path, const Decoder& decode)
+{
+    std::vector<std::string> segments;
+    if ( !path.empty() )
+    {
+        size_t begin = 0;
+        size_t end;
+        while ( ( end = path.find('/', begin) ) != std::string::npos )
+        {
+            segments.push_back(path.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        segments.push_back(path.substr(begin));
+    }
+
+    BindingStats stats{path, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
+    bindings_.push_back(Binding{next_id_, std::move(segments), decode, std::move(stats), true});
+    return next_id_++;
+}
+
+bool ParameterRegistry::unbind(size_t id)
+{
+    for ( auto it = bindings_.begin(); it != bindings_.end(); ++it )
+    {
+        if ( it->id == id )
+        {
+            bindings_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParameterRegistry::update(const std::shared_ptr<const FrozenTree>& tree,
+                               ErrorSink* error_sink)
+{
+    std::vector<PathChange> changes;
+    Parser2::diffYAML(( tree_ ) ? tree_->root() : FrozenNode(),
+                      ( tree ) ? tree->root() : FrozenNode(), changes);
+    tree_ = tree;
+    const FrozenNode root = ( tree ) ? tree->root() : FrozenNode();
+
+    bool success = true;
+    for ( Binding& binding : bindings_ )
+    {
+        bool is_affected = binding.is_pending;
+        for ( size_t i = 0; i < changes.size() && !is_affected; i++ )
+        {
+            is_affected = ChangeNotifier::isAffected(binding.stats.path, changes[i].path);
+        }
+        if ( !is_affected )
+        {
+            continue;
+        }
+
+        const auto start_time = std::chrono::steady_clock::now();
+        success = binding.decode(resolve(root, binding.segments), error_sink) && success;
+        const std::chrono::nanoseconds decode_time =
+            std::chrono::steady_clock::now() - start_time;
+
+        binding.is_pending = false;
+        binding.stats.num_of_decodes++;
+        binding.stats.last_decode_time = decode_time;
+        binding.stats.total_decode_time += decode_time;
+    }
+    return success;
+}
+
+bool ParameterRegistry::update(const YAML::Node& config, ErrorSink* error_sink)
+{
+    return ParameterRegistry::update(std::make_shared<const FrozenTree>(config), error_sink);
+}
+
+std::vector<BindingStats> ParameterRegistry::stats() const
+{
+    std::vector<BindingStats> all_stats;
+    all_stats.reserve(bindings_.size());
+    for ( const Binding& binding : bindings_ )
+    {
+        all_stats.push_back(binding.stats);
+    }
+    return all_stats;
+}
+
+} // namespace yaml_common
+} // namespace kelo
@@ -39,28 +39,53 @@
  ******************************************************************************/
 
 #include "yaml_common/Parser.h"
+#include "yaml_common/Parser2.h"
+#include "yaml_common/KeyFilter.h"
+#include "yaml_common/NumericScalar.h"
 
 namespace kelo
 {
 namespace yaml_common
 {
 
+/**
+ * @brief Resolve the node a getter should read from with a single map scan:
+ * `node` itself when `key` is empty, otherwise the value of `key`
+ *
+ * @return bool false when `key` is given but not present in `node`
+ */
+static bool resolve(const YAML::Node& node, const std::string& key,
+                    YAML::Node& target)
+{
+    if (!node)
+        return false;
+
+    if (key.empty())
+    {
+        target.reset(node);
+        return true;
+    }
+    return Parser2::find(node, key, target, false);
+}
+
 bool Parser::hasMap(const YAML::Node& node, std::string key)
 {
-    if (!node.IsMap() || !node[key])
+    YAML::Node value;
+    if (!node.IsMap() || !Parser2::find(node, key, value, false))
         return false;
 
-    return node[key].IsMap();
+    return value.IsMap();
 }
 
 bool Parser::hasInt(const YAML::Node& node, std::string key)
 {
+    YAML::Node value;
+    if (!resolve(node, key, value))
+        return false;
+
     try
     {
-        if (key.empty())
-            node.as<int>();
-        else
-            node[key].as<int>();
+        value.as<int>();
         return true;
     }
     catch (YAML::Exception&)
@@ -72,12 +97,13 @@ bool Parser::hasInt(const YAML::Node& node, std::string key)
 
 bool Parser::hasDouble(const YAML::Node& node, std::string key)
 {
+    YAML::Node value;
+    if (!resolve(node, key, value))
+        return false;
+
     try
     {
-        if (key.empty())
-            node.as<double>();
-        else
-            node[key].as<double>();
+        value.as<double>();
         return true;
     }
     catch (YAML::Exception&)
@@ -89,20 +115,22 @@ bool Parser::hasDouble(const YAML::Node& node, std::string key)
 
 bool Parser::hasString(const YAML::Node& node, std::string key)
 {
-    if (!node.IsMap() || !node[key]) // TODO check if correct
+    YAML::Node value;
+    if (!node.IsMap() || !Parser2::find(node, key, value, false)) // TODO check if correct
         return false;
 
-    return node[key].IsScalar();
+    return value.IsScalar();
 }
 
 bool Parser::hasBool(const YAML::Node& node, std::string key)
 {
+    YAML::Node value;
+    if (!resolve(node, key, value))
+        return false;
+
     try
     {
-        if (key.empty())
-            node.as<bool>();
-        else
-            node[key].as<bool>();
+        value.as<bool>();
         return true;
     }
     catch (YAML::Exception&)
@@ -115,12 +143,13 @@ bool Parser::hasBool(const YAML::Node& node, std::string key)
 int Parser::getInt(const YAML::Node& node, std::string key)
 {
     int i = 0;
+    YAML::Node value;
+    if (!resolve(node, key, value))
+        return i;
+
     try
     {
-        if (key.empty())
-            i = node.as<int>();
-        else
-            i = node[key].as<int>();
+        i = value.as<int>();
     }
     catch (YAML::Exception&)
     {
@@ -132,12 +161,13 @@ int Parser::getInt(const YAML::Node& node, std::string key)
 double Parser::getDouble(const YAML::Node& node, std::string key)
 {
     double d = 0;
+    YAML::Node value;
+    if (!resolve(node, key, value))
+        return d;
+
     try
     {
-        if (key.empty())
-            d = node.as<double>();
-        else
-            d = node[key].as<double>();
+        d = value.as<double>();
     }
     catch (YAML::Exception&)
     {
@@ -148,16 +178,13 @@ double Parser::getDouble(const YAML::Node& node, std::string key)
 
 std::string Parser::getString(const YAML::Node& node, std::string key)
 {
+    YAML::Node value;
+    if (!resolve(node, key, value))
+        return "";
+
     try
     {
-        if (key.empty())
-        {
-            return node.as<std::string>();
-        }
-        else
-        {
-            return node[key].as<std::string>();
-        }
+        return value.as<std::string>();
     }
     catch (YAML::Exception&)
     {
@@ -170,12 +197,13 @@ bool Parser::getBool(const YAML::Node& node, std::string key,
                          bool defaultValue)
 {
     bool b = defaultValue;
+    YAML::Node value;
+    if (!resolve(node, key, value))
+        return b;
+
     try
     {
-        if (key.empty())
-            b = node.as<bool>();
-        else
-            b = node[key].as<bool>();
+        b = value.as<bool>();
     }
     catch (YAML::Exception&)
     {
@@ -186,10 +214,11 @@ bool Parser::getBool(const YAML::Node& node, std::string key,
 
 unsigned int Parser::getLength(const YAML::Node& node, std::string key)
 {
-    if (!node || !node[key] || !node[key].IsSequence())
+    YAML::Node value;
+    if (!node || !Parser2::find(node, key, value, false) || !value.IsSequence())
         return 0;
 
-    return node[key].size();
+    return value.size();
 }
 
 unsigned int Parser::getLength(const YAML::Node& node)
@@ -203,18 +232,23 @@ unsigned int Parser::getLength(const YAML::Node& node)
 std::vector<std::string> Parser::getAllKeys(const YAML::Node& node)
 {
     std::vector<std::string> keys;
-    for (YAML::const_iterator it = node.begin(); it != node.end(); ++it)
+    if (node.IsMap())
+        keys.reserve(node.size());
+    Parser2::forEachKeyNode(node, [&keys](const YAML::Node& key)
     {
-        keys.push_back(it->first.as<std::string>());
-    }
+        /* non-scalar keys are converted as before, e.g. "null" for ~ */
+        if (key.IsScalar())
+            keys.push_back(key.Scalar());
+        else
+            keys.push_back(key.as<std::string>());
+    }, false);
     return keys;
 }
 
 bool Parser::hasPose(const YAML::Node& node, std::string key)
 {
-    return (node[key] && node[key].IsSequence() && node[key].size() == 3 &&
-            node[key][0].IsScalar() && node[key][1].IsScalar() &&
-            node[key][2].IsScalar());
+    YAML::Node value;
+    return (Parser2::find(node, key, value, false) && hasPose(value));
 }
 
 bool Parser::hasPose(const YAML::Node& node)
@@ -227,12 +261,11 @@ bool Parser::hasPose(const YAML::Node& node)
 geometry_common::Pose2D Parser::getPose(const YAML::Node& node,
                                             std::string key)
 {
-    if (!hasPose(node, key))
+    YAML::Node value;
+    if (!Parser2::find(node, key, value, false))
         return geometry_common::Pose2D();
 
-    const YAML::Node& p = node[key];
-    return geometry_common::Pose2D(p[0].as<double>(), p[1].as<double>(),
-                                   p[2].as<double>());
+    return getPose(value);
 }
 
 geometry_common::Pose2D Parser::getPose(const YAML::Node& node)
@@ -247,116 +280,155 @@ geometry_common::Pose2D Parser::getPose(const YAML::Node& node)
 
 bool Parser::hasTime(const YAML::Node& node, std::string key)
 {
-    return (node[key] && node[key].IsMap() && hasInt(node[key], "high") &&
-            hasInt(node[key], "low"));
+    YAML::Node value;
+    return (Parser2::find(node, key, value, false) && value.IsMap() &&
+            hasInt(value, "high") && hasInt(value, "low"));
 }
 
 long long Parser::getTime(const YAML::Node& node, std::string key)
 {
-    if (!hasTime(node, key))
+    YAML::Node value;
+    if (!Parser2::find(node, key, value, false) || !value.IsMap())
         return 0;
 
-    unsigned int low = (unsigned int)getInt(node[key], "low");
-    unsigned int high = (unsigned int)getInt(node[key], "high");
+    YAML::Node low_value, high_value;
+    if (!Parser2::find(value, "low", low_value, false) ||
+        !Parser2::find(value, "high", high_value, false) ||
+        !hasInt(low_value) || !hasInt(high_value))
+        return 0;
+
+    unsigned int low = (unsigned int)getInt(low_value);
+    unsigned int high = (unsigned int)getInt(high_value);
 
     return (((long long)high) << 32) + low;
 }
 
-void Parser::copyYaml(const YAML::Node& values, YAML::Emitter& yaml,
-                      const std::vector<std::string>& skipKeys)
+/**
+ * @brief Emit a scalar as the first of int, double and bool it converts to,
+ * otherwise as string
+ */
+static void emitScalar(const YAML::Node& node, YAML::Emitter& yaml)
+{
+    if (node.Tag() == "!")
+    { // loaded as string in yaml-cpp
+        yaml << node.Scalar();
+        return;
+    }
+
+    const NumericScalar::Classification classification =
+        NumericScalar::classify(node.Scalar());
+    switch (classification.type)
+    {
+        case ScalarType::INT:
+            yaml << classification.int_value;
+            break;
+        case ScalarType::DOUBLE:
+            yaml << classification.double_value;
+            break;
+        case ScalarType::BOOL:
+            yaml << classification.bool_value;
+            break;
+        default:
+            yaml << node.Scalar();
+            break;
+    }
+}
+
+/**
+ * @brief Key of a map entry as `key.as<std::string>()` converts it (e.g.
+ * "null" for a null key), without copying scalar keys
+ */
+static const std::string& keyString(const YAML::Node& key, std::string& buffer)
+{
+    if (key.IsScalar())
+        return key.Scalar();
+    buffer = key.as<std::string>();
+    return buffer;
+}
+
+/**
+ * @brief Copy the entries of a map or the elements of a sequence which are
+ * not skipped by filter. Scalar keys are emitted straight from the node and
+ * one position is kept per level, reused for all of its entries.
+ */
+static void copyFiltered(const YAML::Node& values, YAML::Emitter& yaml,
+                         const KeyFilter& filter,
+                         const KeyFilter::Position& position)
 {
+    KeyFilter::Position next;
     if (values.IsMap())
     {
-        for (YAML::const_iterator it = values.begin(); it != values.end();
-        ++it)
+        std::string key_buffer;
+        for (const auto& entry : values)
         {
-            std::string key = it->first.as<std::string>();
-            bool skip = false;
-            for (unsigned int i = 0; i < skipKeys.size() && !skip; i++)
-                if (key == skipKeys[i])
-                    skip = true;
+            const std::string& key = keyString(entry.first, key_buffer);
+            if (filter.skip(position, key, next))
+                continue;
 
-            if (!skip)
+            if (entry.second.IsScalar())
+            {
+                yaml << YAML::Key << key << YAML::Value;
+                emitScalar(entry.second, yaml);
+            }
+            else if (entry.second.IsMap())
             {
-                if (it->second.IsScalar())
-                {
-                    if (it->second.Tag() == "!")
-                    { // loaded as string in yaml-cpp
-                        yaml << YAML::Key << key << YAML::Value
-                             << it->second.as<std::string>();
-                    }
-                    else
-                    {
-                        if (hasInt(it->second))
-                            yaml << YAML::Key << key << YAML::Value
-                                 << getInt(it->second);
-                        else if (hasDouble(it->second))
-                            yaml << YAML::Key << key << YAML::Value
-                                 << getDouble(it->second);
-                        else if (hasBool(it->second))
-                            yaml << YAML::Key << key << YAML::Value
-                                 << getBool(it->second);
-                        else
-                            yaml << YAML::Key << key << YAML::Value
-                                 << getString(it->second);
-                    }
-                }
-                else if (it->second.IsMap())
-                {
-                    yaml << YAML::Key << key;
-                    yaml << YAML::BeginMap;
-                    copyYaml(it->second, yaml);
-                    yaml << YAML::EndMap;
-                }
-                else if (it->second.IsSequence())
-                {
-                    yaml << YAML::Key << key;
-                    yaml << YAML::BeginSeq;
-                    copyYaml(it->second, yaml);
-                    yaml << YAML::EndSeq;
-                }
+                yaml << YAML::Key << key;
+                yaml << YAML::BeginMap;
+                copyFiltered(entry.second, yaml, filter, next);
+                yaml << YAML::EndMap;
+            }
+            else if (entry.second.IsSequence())
+            {
+                yaml << YAML::Key << key;
+                yaml << YAML::BeginSeq;
+                copyFiltered(entry.second, yaml, filter, next);
+                yaml << YAML::EndSeq;
             }
         }
     }
     else if (values.IsSequence())
     {
-        for (YAML::const_iterator it = values.begin(); it != values.end();
-        ++it)
+        size_t index = 0;
+        for (const auto& element : values)
         {
-            if (it->IsScalar())
+            if (filter.skip(position, index++, next))
+                continue;
+
+            if (element.IsScalar())
             {
-                if (it->Tag() == "!")
-                { // loaded as string in yaml-cpp
-                    yaml << it->as<std::string>();
-                }
-                else
-                {
-                    if (hasInt(*it))
-                        yaml << getInt(*it);
-                    else if (hasDouble(*it))
-                        yaml << getDouble(*it);
-                    else if (hasBool(*it))
-                        yaml << getBool(*it);
-                    else
-                        yaml << getString(*it);
-                }
+                emitScalar(element, yaml);
             }
-            else if (it->IsMap())
+            else if (element.IsMap())
             {
                 yaml << YAML::BeginMap;
-                copyYaml(*it, yaml);
+                copyFiltered(element, yaml, filter, next);
                 yaml << YAML::EndMap;
             }
-            else if (it->IsSequence())
+            else if (element.IsSequence())
             {
                 yaml << YAML::BeginSeq;
-                copyYaml(*it, yaml);
+                copyFiltered(element, yaml, filter, next);
                 yaml << YAML::EndSeq;
             }
         }
     }
 }
 
+void Parser::copyYaml(const YAML::Node& values, YAML::Emitter& yaml,
+                      const std::vector<std::string>& skipKeys)
+{
+    KeyFilter filter;
+    for (const std::string& key : skipKeys)
+        filter.addLiteralPath(std::vector<std::string>(1, key));
+    copyFiltered(values, yaml, filter, filter.root());
+}
+
+void Parser::copyYaml(const YAML::Node& values, YAML::Emitter& yaml,
+                      const KeyFilter& filter)
+{
+    copyFiltered(values, yaml, filter, filter.root());
+}
+
 void Parser::copyYaml(const YAML::Node& values, YAML::Node& target)
 {
     if (!values.IsMap() || (!target.IsNull() && !target.IsMap()))
@@ -38,71 +38,511 @@
  *
  ******************************************************************************/
 
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <istream>
+#include <map>
+#include <streambuf>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/FileCache.h>
+#include <yaml_common/FrozenNode.h>
 #include <yaml_common/Parser2.h>
+#include <yaml_common/Snapshot.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
 
 namespace kelo
 {
 namespace yaml_common
 {
 
+thread_local ErrorSink* Parser2::active_error_sink_ = nullptr;
+thread_local bool Parser2::is_error_sink_active_ = false;
+
+#ifdef YAML_COMMON_COUNT_KEY_LOOKUPS
+thread_local size_t Parser2::num_of_key_lookups_ = 0;
+#endif // YAML_COMMON_COUNT_KEY_LOOKUPS
+
+/**
+ * @brief Hash index over the scalar keys of a YAML map. Keys are referred to
+ * by pointer to the scalar stored in the node, so building it copies no
+ * strings; it must not outlive the indexed node.
+ */
+struct KeyIndexEntry
+{
+    YAML::Node value;
+    bool is_used;
+};
+
+struct KeyPtrHash
+{
+    size_t operator () (const std::string* key) const
+    {
+        return std::hash<std::string>()(*key);
+    }
+};
+
+struct KeyPtrEqual
+{
+    bool operator () (const std::string* lhs, const std::string* rhs) const
+    {
+        return *lhs == *rhs;
+    }
+};
+
+using KeyIndex = std::unordered_map<const std::string*, KeyIndexEntry,
+                                    KeyPtrHash, KeyPtrEqual>;
+using KeySet = std::unordered_set<const std::string*, KeyPtrHash, KeyPtrEqual>;
+
+/**
+ * @brief Storage of Parser2::defaultErrorSink
+ */
+static std::atomic<ErrorSink*>& defaultErrorSinkStorage()
+{
+    static ConsoleErrorSink console_error_sink;
+    static std::atomic<ErrorSink*> default_error_sink(&console_error_sink);
+    return default_error_sink;
+}
+
+/**
+ * @brief Storage of Parser2::fileCache
+ */
+static std::atomic<FileCache*>& fileCacheStorage()
+{
+    static std::atomic<FileCache*> file_cache(nullptr);
+    return file_cache;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Read-only stream buffer over a memory range, so that an std::istream
+ * can read it without copying it first
+ */
+class MemoryStreamBuffer : public std::streambuf
+{
+    public:
+
+        MemoryStreamBuffer(const char* data, size_t size)
+        {
+            char* begin = const_cast<char*>(data);
+            setg(begin, begin, begin + size);
+        }
+};
+
+/**
+ * @brief Read-only memory mapping of a whole regular file, unmapped on
+ * destruction
+ */
+class MappedFile
+{
+    public:
+
+        explicit MappedFile(const std::string& abs_file_path)
+        {
+            const int fd = ::open(abs_file_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if ( fd < 0 )
+            {
+                return;
+            }
+            struct stat file_stat;
+            if ( ::fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) )
+            {
+                is_regular_ = true;
+                size_ = static_cast<size_t>(file_stat.st_size);
+            }
+            if ( is_regular_ && size_ > 0 )
+            {
+                void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if ( data != MAP_FAILED )
+                {
+                    ::madvise(data, size_, MADV_SEQUENTIAL);
+                    data_ = static_cast<const char*>(data);
+                }
+            }
+            ::close(fd);
+        }
+
+        ~MappedFile()
+        {
+            if ( data_ )
+            {
+                ::munmap(const_cast<char*>(data_), size_);
+            }
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator = (const MappedFile&) = delete;
+
+        /**
+         * @brief Whether the file could be mapped (empty files are mapped to
+         * an empty range)
+         */
+        bool isMapped() const
+        {
+            return is_regular_ && ( data_ || size_ == 0 );
+        }
+
+        const char* data() const
+        {
+            return data_;
+        }
+
+        size_t size() const
+        {
+            return ( data_ ) ? size_ : 0;
+        }
+
+    private:
+
+        const char* data_{nullptr};
+        size_t size_{0};
+        bool is_regular_{false};
+};
+
+/**
+ * @brief Equivalent of YAML::LoadFile that parses a memory mapping of the
+ * file, falling back to YAML::LoadFile for files that cannot be mapped. Files
+ * that cannot be opened are left to YAML::LoadFile as well, so that they throw
+ * the same YAML::BadFile (its constructor differs between yaml-cpp versions).
+ */
+static YAML::Node loadMappedFile(const std::string& abs_file_path)
+{
+    MappedFile file(abs_file_path);
+    if ( !file.isMapped() )
+    {
+        return YAML::LoadFile(abs_file_path);
+    }
+    MemoryStreamBuffer buffer(file.data(), file.size());
+    std::istream stream(&buffer);
+    return YAML::Load(stream);
+}
+#else
+static YAML::Node loadMappedFile(const std::string& abs_file_path)
+{
+    return YAML::LoadFile(abs_file_path);
+}
+#endif // _WIN32
+
+/**
+ * @brief Write the sidecar snapshot of a file parsed into `node`, unless the
+ * file changed since `source_key` was taken before parsing it. Failures (e.g.
+ * a read-only directory) are ignored; the file is parsed again next time.
+ */
+static void updateSidecar(const std::string& abs_file_path, const YAML::Node& node,
+                          const FileCache::Key& source_key)
+{
+    if ( !source_key.isValid() || !Snapshot::saveSidecar(abs_file_path, node) )
+    {
+        return;
+    }
+    if ( !( FileCache::makeKey(abs_file_path) == source_key ) )
+    {
+        /* the snapshot may have recorded a newer version than was parsed */
+        std::remove(Snapshot::sidecarPath(abs_file_path).c_str());
+    }
+}
+
 bool Parser2::loadFile(const std::string& abs_file_path,
                        YAML::Node& node, bool print_error_msg)
 {
-    try
+    return Parser2::loadFile(abs_file_path, node,
+                             Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::loadFile(const std::string& abs_file_path,
+                       YAML::Node& node, ErrorSink* error_sink)
+{
+    return Parser2::loadFile(abs_file_path, node, FileLoadMode::STREAM,
+                             error_sink);
+}
+
+bool Parser2::loadFile(const std::string& abs_file_path,
+                       YAML::Node& node, FileLoadMode mode,
+                       bool print_error_msg)
+{
+    return Parser2::loadFile(abs_file_path, node, mode,
+                             Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::loadFile(const std::string& abs_file_path,
+                       YAML::Node& node, FileLoadMode mode,
+                       ErrorSink* error_sink)
+{
+    FileCache* file_cache = Parser2::fileCache();
+    FileCache::Key key;
+    if ( file_cache )
     {
-        node = YAML::LoadFile(abs_file_path);
+        key = FileCache::makeKey(abs_file_path);
+        const std::shared_ptr<const FrozenTree> cached_tree = file_cache->find(key);
+        if ( cached_tree )
+        {
+            node = cached_tree->root().thaw();
+            return true;
+        }
     }
-    catch( const YAML::BadFile& )
+
+    YAML::Node loaded_node;
+    if ( !Parser2::parseFile(abs_file_path, loaded_node, mode, error_sink) )
     {
-        std::stringstream msg;
-        msg << "YAML threw BadFile exception. Does the file exist?"
-            << std::endl << abs_file_path;
-        Parser2::log(msg.str(), print_error_msg);
         return false;
     }
-    catch( const YAML::ParserException& e )
+    if ( file_cache )
     {
-        std::stringstream msg;
-        msg << "YAML parsing error" << std::endl << e.what();
-        Parser2::log(msg.str(), print_error_msg);
-        return false;
+        file_cache->insert(key, std::make_shared<const FrozenTree>(loaded_node));
     }
+    node = loaded_node;
     return true;
 }
 
-bool Parser2::readAllKeys(const YAML::Node& node, std::vector<std::string>& keys,
-                          bool print_error_msg)
+bool Parser2::loadFile(const std::string& abs_file_path,
+                       std::shared_ptr<const FrozenTree>& tree,
+                       bool print_error_msg)
 {
-    if ( !node.IsMap() )
+    return Parser2::loadFile(abs_file_path, tree,
+                             Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::loadFile(const std::string& abs_file_path,
+                       std::shared_ptr<const FrozenTree>& tree,
+                       ErrorSink* error_sink)
+{
+    return Parser2::loadFile(abs_file_path, tree, FileLoadMode::STREAM,
+                             error_sink);
+}
+
+bool Parser2::loadFile(const std::string& abs_file_path,
+                       std::shared_ptr<const FrozenTree>& tree,
+                       FileLoadMode mode, bool print_error_msg)
+{
+    return Parser2::loadFile(abs_file_path, tree, mode,
+                             Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::loadFile(const std::string& abs_file_path,
+                       std::shared_ptr<const FrozenTree>& tree,
+                       FileLoadMode mode, ErrorSink* error_sink)
+{
+    FileCache* file_cache = Parser2::fileCache();
+    FileCache::Key key;
+    if ( file_cache )
+    {
+        key = FileCache::makeKey(abs_file_path);
+        std::shared_ptr<const FrozenTree> cached_tree = file_cache->find(key);
+        if ( cached_tree )
+        {
+            tree = std::move(cached_tree);
+            return true;
+        }
+    }
+
+    YAML::Node loaded_node;
+    if ( !Parser2::parseFile(abs_file_path, loaded_node, mode, error_sink) )
     {
-        Parser2::log("Given YAML::Node is not a map", print_error_msg);
         return false;
     }
+    std::shared_ptr<const FrozenTree> loaded_tree =
+        std::make_shared<const FrozenTree>(loaded_node);
+    if ( file_cache )
+    {
+        file_cache->insert(key, loaded_tree);
+    }
+    tree = std::move(loaded_tree);
+    return true;
+}
+
+bool Parser2::parseFile(const std::string& abs_file_path,
+                        YAML::Node& node, FileLoadMode mode,
+                        ErrorSink* error_sink)
+{
+    if ( mode == FileLoadMode::SNAPSHOT &&
+         Snapshot::loadSidecar(abs_file_path, node) )
+    {
+        return true;
+    }
 
-    for ( const auto& kv : node )
+    const FileCache::Key source_key = ( mode == FileLoadMode::SNAPSHOT )
+                                      ? FileCache::makeKey(abs_file_path)
+                                      : FileCache::Key();
+    try
     {
-        if ( kv.first.IsScalar() )
+        if ( mode == FileLoadMode::STREAM )
         {
-            keys.push_back(kv.first.Scalar());
+            node = YAML::LoadFile(abs_file_path);
         }
         else
         {
-            Parser2::log("Given YAML::Node map contains a non-scalar key", print_error_msg);
-            return false;
+            node = loadMappedFile(abs_file_path);
         }
     }
+    catch( const YAML::BadFile& )
+    {
+        Parser2::report(error_sink, ErrorCode::BAD_FILE, abs_file_path);
+        return false;
+    }
+    catch( const YAML::ParserException& e )
+    {
+        Parser2::report(error_sink, ErrorCode::PARSE_ERROR, e.what());
+        return false;
+    }
+    if ( mode == FileLoadMode::SNAPSHOT )
+    {
+        updateSidecar(abs_file_path, node, source_key);
+    }
     return true;
 }
 
+bool Parser2::loadFiles(const std::vector<std::string>& abs_file_paths,
+                        std::vector<YAML::Node>& nodes,
+                        std::vector<bool>& is_loaded,
+                        size_t max_num_of_threads, FileLoadMode mode,
+                        bool print_error_msg)
+{
+    return Parser2::loadFiles(abs_file_paths, nodes, is_loaded,
+                              max_num_of_threads, mode,
+                              Parser2::errorSink(print_error_msg));
+}
+
+/**
+ * @brief Keep the errors of one file so that they can be reported in order
+ * once all files were loaded
+ */
+class DeferredErrorSink : public ErrorSink
+{
+    public:
+
+        void report(const Error& error) override
+        {
+            errors_.emplace_back(error.code(), error.detail());
+        }
+
+        void replay(ErrorSink* error_sink) const
+        {
+            for ( const auto& error : errors_ )
+            {
+                error_sink->report(Error(error.first, error.second));
+            }
+        }
+
+    private:
+
+        std::vector<std::pair<ErrorCode, std::string>> errors_;
+
+};
+
+bool Parser2::loadFiles(const std::vector<std::string>& abs_file_paths,
+                        std::vector<YAML::Node>& nodes,
+                        std::vector<bool>& is_loaded,
+                        size_t max_num_of_threads, FileLoadMode mode,
+                        ErrorSink* error_sink)
+{
+    const size_t num_of_files = abs_file_paths.size();
+    nodes.clear();
+    nodes.resize(num_of_files);
+    std::vector<char> is_file_loaded(num_of_files, false);
+    std::vector<DeferredErrorSink> file_error_sinks(
+            ( error_sink ) ? num_of_files : 0);
+
+    /* each thread takes the next file not yet taken until none are left */
+    std::atomic<size_t> next_file_index(0);
+    auto load_files = [&]()
+    {
+        for ( size_t i = next_file_index++; i < num_of_files; i = next_file_index++ )
+        {
+            is_file_loaded[i] = Parser2::loadFile(
+                    abs_file_paths[i], nodes[i], mode,
+                    ( error_sink ) ? &file_error_sinks[i] : nullptr);
+        }
+    };
+
+    size_t num_of_threads = ( max_num_of_threads > 0 )
+                            ? max_num_of_threads
+                            : std::thread::hardware_concurrency();
+    num_of_threads = std::max<size_t>(1, std::min(num_of_threads, num_of_files));
+    std::vector<std::thread> threads;
+    threads.reserve(num_of_threads - 1);
+    for ( size_t i = 1; i < num_of_threads; i++ )
+    {
+        threads.emplace_back(load_files);
+    }
+    load_files();
+    for ( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    is_loaded.assign(is_file_loaded.begin(), is_file_loaded.end());
+    if ( error_sink )
+    {
+        for ( const DeferredErrorSink& file_error_sink : file_error_sinks )
+        {
+            file_error_sink.replay(error_sink);
+        }
+    }
+    return std::all_of(is_file_loaded.begin(), is_file_loaded.end(),
+                       [](char loaded) { return loaded; });
+}
+
+bool Parser2::readAllKeys(const YAML::Node& node, std::vector<std::string>& keys,
+                          bool print_error_msg)
+{
+    return Parser2::readAllKeys(node, keys, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::readAllKeys(const YAML::Node& node, std::vector<std::string>& keys,
+                          ErrorSink* error_sink)
+{
+    if ( node.IsMap() )
+    {
+        keys.reserve(keys.size() + node.size());
+    }
+    return Parser2::forEachKey(node, [&keys](const std::string& key)
+                               { keys.push_back(key); }, error_sink);
+}
+
+bool Parser2::readAllKeys(const YAML::Node& node,
+                          std::vector<const std::string*>& keys,
+                          bool print_error_msg)
+{
+    return Parser2::readAllKeys(node, keys, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::readAllKeys(const YAML::Node& node,
+                          std::vector<const std::string*>& keys,
+                          ErrorSink* error_sink)
+{
+    if ( node.IsMap() )
+    {
+        keys.reserve(keys.size() + node.size());
+    }
+    return Parser2::forEachKey(node, [&keys](const std::string& key)
+                               { keys.push_back(&key); }, error_sink);
+}
+
 bool Parser2::readFloats(
         const YAML::Node& node, const std::vector<std::string>& keys,
         std::vector<float>& values, bool print_error_msg)
+{
+    return Parser2::readFloats(node, keys, values,
+                               Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::readFloats(
+        const YAML::Node& node, const std::vector<std::string>& keys,
+        std::vector<float>& values, ErrorSink* error_sink)
 {
     values.resize(keys.size());
     for ( size_t i = 0; i < keys.size(); i++ )
     {
-        if ( !Parser2::read<float>(node, keys[i], values[i], print_error_msg) )
+        if ( !Parser2::read<float>(node, keys[i], values[i], error_sink) )
         {
             return false;
         }
@@ -112,30 +552,124 @@ bool Parser2::readFloats(
 
 bool Parser2::hasKey(const YAML::Node& node, const std::string& key,
                      bool print_error_msg)
+{
+    return Parser2::hasKey(node, key, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::hasKey(const YAML::Node& node, const std::string& key,
+                     ErrorSink* error_sink)
+{
+    YAML::Node child;
+    return Parser2::find(node, key, child, error_sink);
+}
+
+bool Parser2::find(const YAML::Node& node, const std::string& key,
+                   YAML::Node& child, bool print_error_msg)
+{
+    return Parser2::find(node, key, child, Parser2::errorSink(print_error_msg));
+}
+
+bool Parser2::find(const YAML::Node& node, const std::string& key,
+                   YAML::Node& child, ErrorSink* error_sink)
 {
     if ( key.empty() )
     {
-        Parser2::log("Given key is empty", print_error_msg);
+        Parser2::report(error_sink, ErrorCode::EMPTY_KEY);
         return false;
     }
 
     if ( !node.IsMap() )
     {
-        Parser2::log("Given YAML::Node is not a map", print_error_msg);
+        Parser2::report(error_sink, ErrorCode::NOT_A_MAP);
         return false;
     }
 
-    if ( !node[key] )
+#ifdef YAML_COMMON_COUNT_KEY_LOOKUPS
+    num_of_key_lookups_++;
+#endif // YAML_COMMON_COUNT_KEY_LOOKUPS
+    const YAML::Node value = node[key];
+    if ( !value )
     {
-        std::stringstream msg;
-        msg << "Given YAML::Node does not have key " << key;
-        Parser2::log(msg.str(), print_error_msg);
+        Parser2::report(error_sink, ErrorCode::MISSING_KEY, key);
         return false;
     }
 
+    child.reset(value);
     return true;
 }
 
+/**
+ * @brief Fill the empty map `new_node` with the merge of two non-empty maps
+ *
+ * Keys of `override_node` are indexed once so that each key of `base_node` is
+ * matched in O(1), and entries are added with `force_insert` which, unlike
+ * operator[], does not scan `new_node`. For duplicate keys the first
+ * occurrence wins, as with node[key].
+ */
+static void mergeMaps(YAML::Node& new_node, const YAML::Node& base_node,
+                      const YAML::Node& override_node)
+{
+    KeyIndex override_index(override_node.size());
+    for ( YAML::const_iterator it = override_node.begin(); it != override_node.end(); ++it )
+    {
+        if ( it->first.IsScalar() )
+        {
+            override_index.emplace(&it->first.Scalar(), KeyIndexEntry{it->second, false});
+        }
+    }
+
+    /* Add the mappings of base_node merged with override_node */
+    KeySet base_keys(base_node.size());
+    for ( YAML::const_iterator it = base_node.begin(); it != base_node.end(); ++it )
+    {
+        if ( it->first.IsScalar() )
+        {
+            if ( !base_keys.insert(&it->first.Scalar()).second )
+            {
+                continue; // duplicate key
+            }
+            auto override_it = override_index.find(&it->first.Scalar());
+            if ( override_it != override_index.end() )
+            {
+                override_it->second.is_used = true;
+                const YAML::Node& override_value = override_it->second.value;
+                if ( it->second.IsMap() && it->second.size() && override_value.IsMap() )
+                {
+                    /* insert the child before filling it, so that it shares
+                     * the memory of new_node instead of each nested map
+                     * copying the memory of the whole document */
+                    YAML::Node child(YAML::NodeType::Map);
+                    new_node.force_insert(it->first, child);
+                    mergeMaps(child, it->second, override_value);
+                }
+                else
+                {
+                    new_node.force_insert(it->first, Parser2::mergeYAML(
+                                it->second, override_value));
+                }
+                continue;
+            }
+        }
+        new_node.force_insert(it->first, it->second);
+    }
+
+    /* Add the mappings from 'override_node' not already in 'new_node' */
+    for ( YAML::const_iterator it = override_node.begin(); it != override_node.end(); ++it )
+    {
+        if ( !it->first.IsScalar() )
+        {
+            new_node.force_insert(it->first, it->second);
+            continue;
+        }
+        KeyIndexEntry& entry = override_index.find(&it->first.Scalar())->second;
+        if ( !entry.is_used )
+        {
+            entry.is_used = true;
+            new_node.force_insert(it->first, it->second);
+        }
+    }
+}
+
 YAML::Node Parser2::mergeYAML(const YAML::Node& base_node,
                               const YAML::Node& override_node)
 {
@@ -162,41 +696,489 @@ YAML::Node Parser2::mergeYAML(const YAML::Node& base_node,
     /* Create a new map 'new_node' with the same mappings as base_node,
      * merged with override_node */
     auto new_node = YAML::Node(YAML::NodeType::Map);
-    for ( auto node : base_node )
+    mergeMaps(new_node, base_node, override_node);
+    return new_node;
+}
+
+/**
+ * @brief Merge the map `override_node` into the non-empty map `base_node` in
+ * place. Entries of `base_node` are scanned once (stopping as soon as all keys
+ * of `override_node` were found) and only the matched ones are modified.
+ */
+static void mergeMapsInPlace(YAML::Node& base_node, const YAML::Node& override_node)
+{
+    KeyIndex override_index(override_node.size());
+    for ( YAML::const_iterator it = override_node.begin(); it != override_node.end(); ++it )
+    {
+        if ( it->first.IsScalar() )
+        {
+            override_index.emplace(&it->first.Scalar(), KeyIndexEntry{it->second, false});
+        }
+    }
+
+    /* Update the mappings of base_node present in override_node */
+    size_t num_of_matched_keys = 0;
+    for ( YAML::iterator it = base_node.begin();
+          it != base_node.end() && num_of_matched_keys < override_index.size(); ++it )
+    {
+        if ( !it->first.IsScalar() )
+        {
+            continue;
+        }
+        auto override_it = override_index.find(&it->first.Scalar());
+        if ( override_it == override_index.end() || override_it->second.is_used )
+        {
+            continue;
+        }
+        override_it->second.is_used = true;
+        num_of_matched_keys++;
+        const YAML::Node& override_value = override_it->second.value;
+        if ( override_value.IsNull() )
+        {
+            continue;
+        }
+        if ( it->second.IsMap() && it->second.size() && override_value.IsMap() )
+        {
+            YAML::Node child = it->second;
+            mergeMapsInPlace(child, override_value);
+        }
+        else
+        {
+            it->second = YAML::Clone(override_value);
+        }
+    }
+
+    /* Add the mappings from 'override_node' not present in 'base_node' */
+    for ( YAML::const_iterator it = override_node.begin(); it != override_node.end(); ++it )
+    {
+        if ( !it->first.IsScalar() )
+        {
+            base_node.force_insert(YAML::Clone(it->first), YAML::Clone(it->second));
+            continue;
+        }
+        KeyIndexEntry& entry = override_index.find(&it->first.Scalar())->second;
+        if ( !entry.is_used )
+        {
+            entry.is_used = true;
+            base_node.force_insert(YAML::Clone(it->first), YAML::Clone(it->second));
+        }
+    }
+}
+
+void Parser2::mergeYAMLInPlace(YAML::Node& base_node,
+                               const YAML::Node& override_node)
+{
+    if ( !override_node.IsMap() )
+    {
+        if ( !override_node.IsNull() )
+        {
+            base_node.reset(YAML::Clone(override_node));
+        }
+        return;
+    }
+
+    if ( !base_node.IsMap() || !base_node.size() )
+    {
+        base_node.reset(YAML::Clone(override_node));
+        return;
+    }
+
+    mergeMapsInPlace(base_node, override_node);
+}
+
+/**
+ * @brief Value of a key in one of the layers given to Parser2::mergeLayers
+ */
+struct LayerValue
+{
+    YAML::Node value;
+    size_t layer;
+};
+
+using LayerOrigins = std::map<std::string, size_t>;
+
+static std::string joinKeyPath(const std::string& path, const std::string& key)
+{
+    return ( path.empty() ) ? key : path + "/" + key;
+}
+
+/**
+ * @brief Reduce the values a key has in consecutive layers to the ones that
+ * make up its merged value, following the rules of Parser2::mergeYAML: a null
+ * value is ignored, a non-map value replaces everything before it and a map
+ * replaces a preceding non-map or empty map. Either a single value, which is
+ * used as is, or two or more maps to be merged remain.
+ */
+static void reduceLayerValues(const std::vector<LayerValue>& values,
+                              std::vector<LayerValue>& reduced)
+{
+    reduced.clear();
+    reduced.push_back(values.front());
+    for ( size_t i = 1; i < values.size(); i++ )
+    {
+        const YAML::Node& value = values[i].value;
+        if ( value.IsNull() )
+        {
+            continue;
+        }
+        if ( value.IsMap() && ( reduced.size() > 1 ||
+                                ( reduced.front().value.IsMap() &&
+                                  reduced.front().value.size() ) ) )
+        {
+            reduced.push_back(values[i]);
+        }
+        else
+        {
+            reduced.clear();
+            reduced.push_back(values[i]);
+        }
+    }
+}
+
+/**
+ * @brief Record `layer` as the origin of every leaf under `node`
+ */
+static void recordOrigins(const YAML::Node& node, size_t layer,
+                          const std::string& path, LayerOrigins& origins)
+{
+    if ( !node.IsMap() || !node.size() )
+    {
+        origins[path] = layer;
+        return;
+    }
+    for ( YAML::const_iterator it = node.begin(); it != node.end(); ++it )
+    {
+        if ( it->first.IsScalar() )
+        {
+            recordOrigins(it->second, layer,
+                          joinKeyPath(path, it->first.Scalar()), origins);
+        }
+    }
+}
+
+/**
+ * @brief Fill the empty map `new_node` with the merge of `maps`. Each key
+ * collects its values from all maps in one pass (keeping the order of first
+ * appearance), which are then reduced and merged recursively.
+ */
+static void mergeLayerMaps(YAML::Node& new_node, const std::vector<LayerValue>& maps,
+                           const std::string& path, LayerOrigins* origins)
+{
+    struct KeyValues
+    {
+        YAML::Node key;
+        std::vector<LayerValue> values;
+    };
+    std::vector<KeyValues> entries;
+    std::unordered_map<const std::string*, size_t, KeyPtrHash, KeyPtrEqual> index;
+    for ( const LayerValue& map : maps )
     {
-        if ( node.first.IsScalar() )
+        for ( YAML::const_iterator it = map.value.begin(); it != map.value.end(); ++it )
         {
-            const std::string& key = node.first.Scalar();
-            if ( override_node[key] )
+            if ( !it->first.IsScalar() )
             {
-                new_node[node.first.Scalar()] = Parser2::mergeYAML(
-                        node.second, override_node[key]);
+                entries.push_back(KeyValues{it->first, {LayerValue{it->second, map.layer}}});
                 continue;
             }
+            auto inserted = index.emplace(&it->first.Scalar(), entries.size());
+            if ( inserted.second )
+            {
+                entries.push_back(KeyValues{it->first, {LayerValue{it->second, map.layer}}});
+            }
+            else if ( entries[inserted.first->second].values.back().layer != map.layer )
+            {
+                // for duplicate keys within a layer the first occurrence wins
+                entries[inserted.first->second].values.push_back(
+                        LayerValue{it->second, map.layer});
+            }
         }
-        new_node[node.first.Scalar()] = node.second;
     }
 
-    /* Add the mappings from 'override_node' not already in 'new_node' */
-    for ( auto node : override_node )
+    std::vector<LayerValue> reduced;
+    for ( const KeyValues& entry : entries )
     {
-        if ( !node.first.IsScalar() || !new_node[node.first.Scalar()] )
+        if ( !entry.key.IsScalar() )
         {
-            new_node[node.first.Scalar()] = node.second;
+            new_node.force_insert(entry.key, entry.values.front().value);
+            continue;
+        }
+        reduceLayerValues(entry.values, reduced);
+        if ( reduced.size() == 1 )
+        {
+            new_node.force_insert(entry.key, reduced.front().value);
+            if ( origins )
+            {
+                recordOrigins(reduced.front().value, reduced.front().layer,
+                              joinKeyPath(path, entry.key.Scalar()), *origins);
+            }
+        }
+        else
+        {
+            /* insert the child before filling it (see mergeMaps) */
+            YAML::Node child(YAML::NodeType::Map);
+            new_node.force_insert(entry.key, child);
+            mergeLayerMaps(child, reduced, joinKeyPath(path, entry.key.Scalar()),
+                           origins);
         }
     }
-    return YAML::Node(new_node);
+}
+
+YAML::Node Parser2::mergeLayers(const std::vector<YAML::Node>& layers,
+                                std::map<std::string, size_t>* origins)
+{
+    if ( origins )
+    {
+        origins->clear();
+    }
+    if ( layers.empty() )
+    {
+        return YAML::Node();
+    }
+
+    std::vector<LayerValue> values;
+    values.reserve(layers.size());
+    for ( size_t i = 0; i < layers.size(); i++ )
+    {
+        values.push_back(LayerValue{layers[i], i});
+    }
+    std::vector<LayerValue> reduced;
+    reduceLayerValues(values, reduced);
+    if ( reduced.size() == 1 )
+    {
+        if ( origins )
+        {
+            recordOrigins(reduced.front().value, reduced.front().layer, "", *origins);
+        }
+        return reduced.front().value;
+    }
+
+    auto new_node = YAML::Node(YAML::NodeType::Map);
+    mergeLayerMaps(new_node, reduced, "", origins);
+    return new_node;
+}
+
+/**
+ * @brief Append `key` to the key path in `path`; shrink `path` back to its
+ * returned length afterwards
+ */
+static size_t appendKeyPath(std::string& path, const std::string& key)
+{
+    const size_t length = path.size();
+    if ( length > 0 )
+    {
+        path += '/';
+    }
+    path += key;
+    return length;
+}
+
+static bool hasOnlyScalarKeys(const YAML::Node& map)
+{
+    for ( const auto& entry : map )
+    {
+        if ( !entry.first.IsScalar() )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compare types, tags, scalars and entries in order of two nodes
+ */
+static bool isEqual(const YAML::Node& lhs, const YAML::Node& rhs)
+{
+    if ( lhs.is(rhs) )
+    {
+        return true;
+    }
+    if ( lhs.Type() != rhs.Type() || lhs.Tag() != rhs.Tag() )
+    {
+        return false;
+    }
+    if ( lhs.IsScalar() )
+    {
+        return ( lhs.Scalar() == rhs.Scalar() );
+    }
+    if ( !lhs.IsMap() && !lhs.IsSequence() )
+    {
+        return true;
+    }
+    if ( lhs.size() != rhs.size() )
+    {
+        return false;
+    }
+    YAML::const_iterator rhs_it = rhs.begin();
+    for ( const auto& entry : lhs )
+    {
+        const auto other = *rhs_it;
+        ++rhs_it;
+        if ( ( lhs.IsMap() ) ? !isEqual(entry.first, other.first) ||
+                               !isEqual(entry.second, other.second)
+                             : !isEqual(entry, other) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void diffNodes(const YAML::Node& old_node, const YAML::Node& new_node,
+                      std::string& path, std::vector<PathChange>& changes);
+
+/**
+ * @brief Diff two maps with scalar keys. Keys of `new_node` are indexed once,
+ * so each key of `old_node` is matched in O(1); for duplicate keys only the
+ * first occurrence counts, as with node[key].
+ */
+static void diffMaps(const YAML::Node& old_node, const YAML::Node& new_node,
+                     std::string& path, std::vector<PathChange>& changes)
+{
+    KeyIndex new_index(new_node.size());
+    for ( const auto& entry : new_node )
+    {
+        new_index.emplace(&entry.first.Scalar(), KeyIndexEntry{entry.second, false});
+    }
+
+    KeySet old_keys(old_node.size());
+    for ( const auto& entry : old_node )
+    {
+        const std::string& key = entry.first.Scalar();
+        if ( !old_keys.insert(&key).second )
+        {
+            continue; // duplicate key
+        }
+        const size_t length = appendKeyPath(path, key);
+        auto new_it = new_index.find(&key);
+        if ( new_it == new_index.end() )
+        {
+            changes.push_back(PathChange{ChangeType::REMOVED, path});
+        }
+        else
+        {
+            new_it->second.is_used = true;
+            diffNodes(entry.second, new_it->second.value, path, changes);
+        }
+        path.resize(length);
+    }
+
+    for ( const auto& entry : new_node )
+    {
+        KeyIndexEntry& index_entry = new_index.find(&entry.first.Scalar())->second;
+        if ( !index_entry.is_used )
+        {
+            index_entry.is_used = true;
+            const size_t length = appendKeyPath(path, entry.first.Scalar());
+            changes.push_back(PathChange{ChangeType::ADDED, path});
+            path.resize(length);
+        }
+    }
+}
+
+static void diffSequences(const YAML::Node& old_node, const YAML::Node& new_node,
+                          std::string& path, std::vector<PathChange>& changes)
+{
+    YAML::const_iterator old_it = old_node.begin();
+    YAML::const_iterator new_it = new_node.begin();
+    for ( size_t i = 0; old_it != old_node.end() || new_it != new_node.end(); i++ )
+    {
+        const size_t length = appendKeyPath(path, std::to_string(i));
+        if ( new_it == new_node.end() )
+        {
+            changes.push_back(PathChange{ChangeType::REMOVED, path});
+            ++old_it;
+        }
+        else if ( old_it == old_node.end() )
+        {
+            changes.push_back(PathChange{ChangeType::ADDED, path});
+            ++new_it;
+        }
+        else
+        {
+            const YAML::Node old_element = *old_it;
+            const YAML::Node new_element = *new_it;
+            diffNodes(old_element, new_element, path, changes);
+            ++old_it;
+            ++new_it;
+        }
+        path.resize(length);
+    }
+}
+
+static void diffNodes(const YAML::Node& old_node, const YAML::Node& new_node,
+                      std::string& path, std::vector<PathChange>& changes)
+{
+    if ( old_node.is(new_node) )
+    {
+        return;
+    }
+    if ( old_node.IsMap() && new_node.IsMap() && old_node.Tag() == new_node.Tag() &&
+         hasOnlyScalarKeys(old_node) && hasOnlyScalarKeys(new_node) )
+    {
+        diffMaps(old_node, new_node, path, changes);
+    }
+    else if ( old_node.IsSequence() && new_node.IsSequence() &&
+              old_node.Tag() == new_node.Tag() )
+    {
+        diffSequences(old_node, new_node, path, changes);
+    }
+    else if ( !isEqual(old_node, new_node) )
+    {
+        changes.push_back(PathChange{ChangeType::CHANGED, path});
+    }
+}
+
+void Parser2::diffYAML(const YAML::Node& old_node, const YAML::Node& new_node,
+                       std::vector<PathChange>& changes)
+{
+    std::string path;
+    if ( !old_node.IsDefined() || !new_node.IsDefined() )
+    {
+        if ( old_node.IsDefined() != new_node.IsDefined() )
+        {
+            changes.push_back(PathChange{( new_node.IsDefined() ) ? ChangeType::ADDED
+                                                                  : ChangeType::REMOVED,
+                                         path});
+        }
+        return;
+    }
+    diffNodes(old_node, new_node, path, changes);
+}
+
+ErrorSink* Parser2::defaultErrorSink()
+{
+    return defaultErrorSinkStorage().load();
+}
+
+void Parser2::setDefaultErrorSink(ErrorSink* error_sink)
+{
+    defaultErrorSinkStorage().store(error_sink);
+}
+
+FileCache* Parser2::fileCache()
+{
+    return fileCacheStorage().load();
+}
+
+void Parser2::setFileCache(FileCache* file_cache)
+{
+    fileCacheStorage().store(file_cache);
 }
 
 void Parser2::log(const std::string& msg, bool print_error_msg)
 {
     if ( print_error_msg )
     {
-        std::cout << "\033[31m" // change terminal color to red
-                  << "[Parser2] "
-                  << msg
-                  << "\033[0m" // restore terminal color
-                  << std::endl;
+        Parser2::report(Parser2::defaultErrorSink(), ErrorCode::OTHER, msg);
+    }
+}
+
+void Parser2::report(ErrorSink* error_sink, ErrorCode code, const std::string& detail)
+{
+    if ( error_sink != nullptr )
+    {
+        error_sink->report(Error(code, detail));
     }
 }
 
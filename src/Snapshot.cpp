@@ -0,0 +1,584 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <yaml_common/FileCache.h>
+#include <yaml_common/Snapshot.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+namespace
+{
+
+const char snapshot_magic[8] = {'Y', 'A', 'M', 'L', 'S', 'N', 'A', 'P'};
+const uint32_t snapshot_version = 1;
+const uint32_t snapshot_byte_order = 0x01020304;
+
+/**
+ * @brief Fixed size header at the start of every snapshot
+ */
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    int64_t source_mtime_ns; ///< modification time of the source file
+    uint64_t source_size; ///< size of the source file
+    uint64_t has_source; ///< whether the source fields are set
+};
+
+/**
+ * @brief Kind of a serialized node. Nodes referred to by a later ALIAS have
+ * the ANCHOR bit set and are numbered in the order they are written.
+ */
+enum NodeKind : uint8_t
+{
+    UNDEFINED = 0,
+    NULL_NODE = 1,
+    SCALAR = 2,
+    SEQUENCE = 3,
+    MAP = 4,
+    ALIAS = 5,
+    ANCHOR = 0x80
+};
+
+class SnapshotWriter
+{
+    public:
+
+        explicit SnapshotWriter(std::string& data):
+            data_(data) {}
+
+        /**
+         * @brief Find nodes that occur more than once in the tree (through
+         * aliases). yaml-cpp does not expose node identity, so candidates are
+         * nodes of the same source position that are the same node.
+         */
+        void countNodes(const YAML::Node& node)
+        {
+            if ( !node.IsDefined() )
+            {
+                return;
+            }
+            const int pos = node.Mark().pos;
+            if ( pos >= 0 )
+            {
+                Identity* identity = findIdentity(node, pos);
+                if ( identity )
+                {
+                    identity->count++;
+                    return;
+                }
+                identities_[pos].push_back(Identity{node, 1, 0, false});
+            }
+            for ( YAML::const_iterator it = node.begin(); it != node.end(); ++it )
+            {
+                if ( node.IsMap() )
+                {
+                    countNodes(it->first);
+                    countNodes(it->second);
+                }
+                else
+                {
+                    countNodes(*it);
+                }
+            }
+        }
+
+        void writeNode(const YAML::Node& node)
+        {
+            if ( !node.IsDefined() )
+            {
+                data_.push_back(static_cast<char>(UNDEFINED));
+                return;
+            }
+
+            uint8_t anchor_flag = 0;
+            const int pos = node.Mark().pos;
+            Identity* identity = ( pos >= 0 ) ? findIdentity(node, pos) : nullptr;
+            if ( identity && identity->count > 1 )
+            {
+                if ( identity->is_written )
+                {
+                    data_.push_back(static_cast<char>(ALIAS));
+                    writeVarint(identity->anchor_id);
+                    return;
+                }
+                identity->is_written = true;
+                identity->anchor_id = num_of_anchors_++;
+                anchor_flag = ANCHOR;
+            }
+
+            switch ( node.Type() )
+            {
+                case YAML::NodeType::Scalar:
+                    writeHeader(SCALAR | anchor_flag, node);
+                    writeString(node.Scalar());
+                    break;
+                case YAML::NodeType::Sequence:
+                    writeHeader(SEQUENCE | anchor_flag, node);
+                    writeVarint(node.size());
+                    for ( YAML::const_iterator it = node.begin(); it != node.end(); ++it )
+                    {
+                        writeNode(*it);
+                    }
+                    break;
+                case YAML::NodeType::Map:
+                    writeHeader(MAP | anchor_flag, node);
+                    writeVarint(node.size());
+                    for ( YAML::const_iterator it = node.begin(); it != node.end(); ++it )
+                    {
+                        writeNode(it->first);
+                        writeNode(it->second);
+                    }
+                    break;
+                default:
+                    writeHeader(NULL_NODE | anchor_flag, node);
+                    break;
+            }
+        }
+
+    private:
+
+        struct Identity
+        {
+            YAML::Node node;
+            size_t count;
+            size_t anchor_id;
+            bool is_written;
+        };
+
+        Identity* findIdentity(const YAML::Node& node, int pos)
+        {
+            auto it = identities_.find(pos);
+            if ( it != identities_.end() )
+            {
+                for ( Identity& identity : it->second )
+                {
+                    if ( identity.node.is(node) )
+                    {
+                        return &identity;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        void writeHeader(uint8_t kind, const YAML::Node& node)
+        {
+            data_.push_back(static_cast<char>(kind));
+            data_.push_back(static_cast<char>(node.Style()));
+            writeString(node.Tag());
+        }
+
+        void writeVarint(uint64_t value)
+        {
+            while ( value >= 0x80 )
+            {
+                data_.push_back(static_cast<char>(( value & 0x7F ) | 0x80));
+                value >>= 7;
+            }
+            data_.push_back(static_cast<char>(value));
+        }
+
+        void writeString(const std::string& value)
+        {
+            writeVarint(value.size());
+            data_.append(value);
+        }
+
+        std::string& data_;
+        std::unordered_map<int, std::vector<Identity>> identities_;
+        size_t num_of_anchors_{0};
+
+};
+
+class SnapshotReader
+{
+    public:
+
+        SnapshotReader(const char* data, size_t size):
+            data_(data),
+            end_(data + size),
+            factory_(YAML::NodeType::Sequence) {}
+
+        /**
+         * @brief Read a complete node (including its children) into `node`
+         */
+        bool readTree(YAML::Node& node)
+        {
+            uint64_t num_of_children = 0;
+            uint8_t kind = 0;
+            return readNode(node, kind, num_of_children) &&
+                   readChildren(node, kind, num_of_children);
+        }
+
+        bool isAtEnd() const
+        {
+            return data_ == end_;
+        }
+
+    private:
+
+        /**
+         * @brief Create `node` without its children, so that containers can be
+         * added to their parent before being filled.
+         */
+        bool readNode(YAML::Node& node, uint8_t& kind, uint64_t& num_of_children)
+        {
+            num_of_children = 0;
+            if ( !readByte(kind) )
+            {
+                return false;
+            }
+            if ( kind == ALIAS )
+            {
+                uint64_t anchor_id = 0;
+                if ( !readVarint(anchor_id) || anchor_id >= anchors_.size() )
+                {
+                    return false;
+                }
+                node.reset(anchors_[anchor_id]);
+                return true;
+            }
+            if ( kind == UNDEFINED )
+            {
+                node.reset(YAML::Node(YAML::NodeType::Undefined));
+                return true;
+            }
+
+            uint8_t style = 0;
+            if ( !readByte(style) || style > YAML::EmitterStyle::Flow ||
+                 !readString(tag_) )
+            {
+                return false;
+            }
+            const bool is_anchor = kind & ANCHOR;
+            kind &= ~ANCHOR;
+            if ( kind == SCALAR )
+            {
+                if ( !readString(scalar_) )
+                {
+                    return false;
+                }
+            }
+            else if ( kind == SEQUENCE || kind == MAP )
+            {
+                /* each child takes at least one byte */
+                if ( !readVarint(num_of_children) ||
+                     num_of_children > static_cast<uint64_t>(end_ - data_) )
+                {
+                    return false;
+                }
+            }
+            else if ( kind != NULL_NODE )
+            {
+                return false;
+            }
+
+            createNode(node);
+            if ( kind == SCALAR )
+            {
+                node = scalar_;
+            }
+            else if ( num_of_children == 0 && kind != NULL_NODE )
+            {
+                /* non-empty containers get their type with the first child */
+                node = YAML::Node(( kind == MAP ) ? YAML::NodeType::Map
+                                                  : YAML::NodeType::Sequence);
+            }
+            if ( !tag_.empty() )
+            {
+                node.SetTag(tag_);
+            }
+            /* also marks the node as defined (a null node until filled) */
+            node.SetStyle(static_cast<YAML::EmitterStyle::value>(style));
+            if ( is_anchor )
+            {
+                anchors_.push_back(node);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Create a node in the memory shared by all nodes of the
+         * snapshot. Standalone nodes would each allocate their own memory,
+         * which yaml-cpp merges into the parent's on insertion.
+         */
+        void createNode(YAML::Node& node)
+        {
+            node.reset(factory_[factory_.size()]);
+        }
+
+        bool readChildren(YAML::Node& node, uint8_t kind, uint64_t num_of_children)
+        {
+            uint8_t child_kind = 0;
+            uint64_t num_of_grandchildren = 0;
+            for ( uint64_t i = 0; i < num_of_children; i++ )
+            {
+                YAML::Node key;
+                if ( kind == MAP && !readTree(key) )
+                {
+                    return false;
+                }
+                YAML::Node child;
+                if ( !readNode(child, child_kind, num_of_grandchildren) )
+                {
+                    return false;
+                }
+                if ( kind == MAP )
+                {
+                    node.force_insert(key, child);
+                }
+                else
+                {
+                    node.push_back(child);
+                }
+                if ( !readChildren(child, child_kind, num_of_grandchildren) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool readByte(uint8_t& value)
+        {
+            if ( data_ == end_ )
+            {
+                return false;
+            }
+            value = static_cast<uint8_t>(*data_++);
+            return true;
+        }
+
+        bool readVarint(uint64_t& value)
+        {
+            value = 0;
+            for ( unsigned int shift = 0; shift < 64; shift += 7 )
+            {
+                uint8_t byte = 0;
+                if ( !readByte(byte) )
+                {
+                    return false;
+                }
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ( !( byte & 0x80 ) )
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool readString(std::string& value)
+        {
+            uint64_t size = 0;
+            if ( !readVarint(size) || size > static_cast<uint64_t>(end_ - data_) )
+            {
+                return false;
+            }
+            value.assign(data_, size);
+            data_ += size;
+            return true;
+        }
+
+        const char* data_;
+        const char* end_;
+        YAML::Node factory_;
+        std::vector<YAML::Node> anchors_;
+        std::string tag_;
+        std::string scalar_;
+
+};
+
+void serializeWithHeader(const YAML::Node& node, const FileCache::Key* source_key,
+                         std::string& data)
+{
+    SnapshotHeader header;
+    std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+    header.version = snapshot_version;
+    header.byte_order = snapshot_byte_order;
+    header.source_mtime_ns = ( source_key ) ? source_key->mtime_ns : 0;
+    header.source_size = ( source_key ) ? source_key->size : 0;
+    header.has_source = ( source_key ) ? 1 : 0;
+    data.assign(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    SnapshotWriter writer(data);
+    writer.countNodes(node);
+    writer.writeNode(node);
+}
+
+bool readHeader(const char* data, size_t size, SnapshotHeader& header)
+{
+    if ( size < sizeof(header) )
+    {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    return std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) == 0 &&
+           header.version == snapshot_version &&
+           header.byte_order == snapshot_byte_order;
+}
+
+bool readFile(const std::string& file_path, std::string& data)
+{
+    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+    if ( !file )
+    {
+        return false;
+    }
+    const std::streamoff size = file.tellg();
+    if ( size < 0 )
+    {
+        return false;
+    }
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(&data[0], size));
+}
+
+/**
+ * @brief Write `data` to a temporary file next to `file_path` and rename it,
+ * so that readers never see a partially written file
+ */
+bool writeFileAtomically(const std::string& file_path, const std::string& data)
+{
+    std::ostringstream tmp_file_path;
+    tmp_file_path << file_path << ".tmp" << std::this_thread::get_id();
+    {
+        std::ofstream file(tmp_file_path.str(), std::ios::binary | std::ios::trunc);
+        if ( !file.write(data.data(), data.size()) || !file.flush() )
+        {
+            std::remove(tmp_file_path.str().c_str());
+            return false;
+        }
+    }
+    if ( std::rename(tmp_file_path.str().c_str(), file_path.c_str()) != 0 )
+    {
+        std::remove(tmp_file_path.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void Snapshot::serialize(const YAML::Node& node, std::string& data)
+{
+    serializeWithHeader(node, nullptr, data);
+}
+
+bool Snapshot::deserialize(const char* data, size_t size, YAML::Node& node)
+{
+    SnapshotHeader header;
+    if ( !readHeader(data, size, header) )
+    {
+        return false;
+    }
+    SnapshotReader reader(data + sizeof(header), size - sizeof(header));
+    YAML::Node loaded_node;
+    if ( !reader.readTree(loaded_node) || !reader.isAtEnd() )
+    {
+        return false;
+    }
+    node = loaded_node;
+    return true;
+}
+
+bool Snapshot::save(const YAML::Node& node, const std::string& file_path)
+{
+    std::string data;
+    Snapshot::serialize(node, data);
+    return writeFileAtomically(file_path, data);
+}
+
+bool Snapshot::load(const std::string& file_path, YAML::Node& node)
+{
+    std::string data;
+    return readFile(file_path, data) &&
+           Snapshot::deserialize(data.data(), data.size(), node);
+}
+
+std::string Snapshot::sidecarPath(const std::string& abs_file_path)
+{
+    return abs_file_path + ".snapshot";
+}
+
+bool Snapshot::saveSidecar(const std::string& abs_file_path,
+                           const YAML::Node& node)
+{
+    const FileCache::Key source_key = FileCache::makeKey(abs_file_path);
+    if ( !source_key.isValid() )
+    {
+        return false;
+    }
+    std::string data;
+    serializeWithHeader(node, &source_key, data);
+    return writeFileAtomically(Snapshot::sidecarPath(abs_file_path), data);
+}
+
+bool Snapshot::loadSidecar(const std::string& abs_file_path,
+                           YAML::Node& node)
+{
+    const FileCache::Key source_key = FileCache::makeKey(abs_file_path);
+    std::string data;
+    SnapshotHeader header;
+    return source_key.isValid() &&
+           readFile(Snapshot::sidecarPath(abs_file_path), data) &&
+           readHeader(data.data(), data.size(), header) &&
+           header.has_source &&
+           header.source_mtime_ns == source_key.mtime_ns &&
+           header.source_size == source_key.size &&
+           Snapshot::deserialize(data.data(), data.size(), node);
+}
+
+} // namespace yaml_common
+} // namespace kelo
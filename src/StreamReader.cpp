@@ -0,0 +1,438 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin B.
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <yaml-cpp/eventhandler.h>
+#include <yaml_common/StreamReader.h>
+
+namespace kelo
+{
+namespace yaml_common
+{
+namespace detail
+{
+
+void ElementNodeBuilder::onNull()
+{
+    add(YAML::Node(YAML::NodeType::Null), false);
+}
+
+void ElementNodeBuilder::onScalar(const std::string& tag, const std::string& value)
+{
+    YAML::Node node(value);
+    node.SetTag(tag);
+    add(node, false);
+}
+
+void ElementNodeBuilder::onSequenceStart(const std::string& tag,
+                                         YAML::EmitterStyle::value style)
+{
+    YAML::Node node(YAML::NodeType::Sequence);
+    node.SetTag(tag);
+    node.SetStyle(style);
+    add(node, true);
+}
+
+void ElementNodeBuilder::onMapStart(const std::string& tag,
+                                    YAML::EmitterStyle::value style)
+{
+    YAML::Node node(YAML::NodeType::Map);
+    node.SetTag(tag);
+    node.SetStyle(style);
+    add(node, true);
+}
+
+void ElementNodeBuilder::onEnd()
+{
+    stack_.pop_back();
+}
+
+void ElementNodeBuilder::add(const YAML::Node& node, bool is_container)
+{
+    if ( stack_.empty() )
+    {
+        element_.reset(node);
+    }
+    else
+    {
+        Frame& parent = stack_.back();
+        if ( parent.node.IsSequence() )
+        {
+            parent.node.push_back(node);
+        }
+        else if ( !parent.has_key )
+        {
+            parent.key.reset(node);
+            parent.has_key = true;
+        }
+        else
+        {
+            parent.node.force_insert(parent.key, node);
+            parent.has_key = false;
+        }
+    }
+    if ( is_container )
+    {
+        stack_.push_back(Frame{node, YAML::Node(), false});
+    }
+}
+
+std::string elementPath(const std::vector<std::string>& key_path, size_t index)
+{
+    std::string path;
+    for ( const std::string& key : key_path )
+    {
+        path += ( path.empty() ) ? key : "/" + key;
+    }
+    return path + "[" + std::to_string(index) + "]";
+}
+
+/**
+ * @brief Thrown from the event handler to stop the parser early
+ */
+struct StopParsing {};
+
+/**
+ * @brief Follow the parser events down a key path and forward the events of
+ * the elements of the sequence found there to an ElementHandler
+ */
+class SequenceEventHandler : public YAML::EventHandler
+{
+    public:
+
+        SequenceEventHandler(const std::vector<std::string>& key_path,
+                             ElementHandler& handler):
+            key_path_(key_path),
+            handler_(handler) {}
+
+        void OnDocumentStart(const YAML::Mark& /*mark*/) override {}
+
+        void OnDocumentEnd() override {}
+
+        void OnNull(const YAML::Mark& /*mark*/, YAML::anchor_t /*anchor*/) override
+        {
+            if ( element_depth_ > 0 || onScalarNode(nullptr) == Role::ELEMENT )
+            {
+                handler_.onNull();
+                endElementIfComplete();
+            }
+        }
+
+        void OnAlias(const YAML::Mark& /*mark*/, YAML::anchor_t /*anchor*/) override
+        {
+            if ( element_depth_ > 0 )
+            {
+                is_alias_found_ = true;
+                throw StopParsing();
+            }
+            const Role role = nextRole(nullptr);
+            if ( role == Role::ELEMENT || role == Role::PATH || role == Role::TARGET )
+            {
+                is_alias_found_ = true;
+                throw StopParsing();
+            }
+        }
+
+        void OnScalar(const YAML::Mark& /*mark*/, const std::string& tag,
+                      YAML::anchor_t /*anchor*/, const std::string& value) override
+        {
+            if ( element_depth_ > 0 || onScalarNode(&value) == Role::ELEMENT )
+            {
+                handler_.onScalar(tag, value);
+                endElementIfComplete();
+            }
+        }
+
+        void OnSequenceStart(const YAML::Mark& /*mark*/, const std::string& tag,
+                             YAML::anchor_t /*anchor*/,
+                             YAML::EmitterStyle::value style) override
+        {
+            if ( element_depth_ > 0 || pushFrame(nextRole(nullptr), false) )
+            {
+                handler_.onSequenceStart(tag, style);
+                element_depth_++;
+            }
+        }
+
+        void OnSequenceEnd() override
+        {
+            onContainerEnd();
+        }
+
+        void OnMapStart(const YAML::Mark& /*mark*/, const std::string& tag,
+                        YAML::anchor_t /*anchor*/,
+                        YAML::EmitterStyle::value style) override
+        {
+            if ( element_depth_ > 0 || pushFrame(nextRole(nullptr), true) )
+            {
+                handler_.onMapStart(tag, style);
+                element_depth_++;
+            }
+        }
+
+        void OnMapEnd() override
+        {
+            onContainerEnd();
+        }
+
+        bool isFound() const
+        {
+            return is_found_;
+        }
+
+        bool isSequence() const
+        {
+            return is_sequence_;
+        }
+
+        bool isAliasFound() const
+        {
+            return is_alias_found_;
+        }
+
+    private:
+
+        enum class Role
+        {
+            SKIP, ///< not on the key path
+            PATH, ///< on the key path, before its end
+            TARGET, ///< at the end of the key path
+            ELEMENT ///< element of the target sequence
+        };
+
+        struct Frame
+        {
+            Role role;
+            size_t path_depth; ///< number of keys of key_path_ matched
+            bool is_map;
+            bool is_key_next;
+            Role next_role; ///< role of the value of the current key
+        };
+
+        /**
+         * @brief Role of the node whose event was just received (`scalar` is
+         * its value for scalars, `nullptr` otherwise). Updates the key/value
+         * state of the enclosing map.
+         */
+        Role nextRole(const std::string* scalar)
+        {
+            if ( stack_.empty() )
+            {
+                next_path_depth_ = 0;
+                return ( key_path_.empty() ) ? Role::TARGET : Role::PATH;
+            }
+            Frame& parent = stack_.back();
+            if ( parent.role == Role::TARGET )
+            {
+                return Role::ELEMENT;
+            }
+            if ( parent.role != Role::PATH || !parent.is_map )
+            {
+                return Role::SKIP;
+            }
+            if ( parent.is_key_next )
+            {
+                parent.is_key_next = false;
+                if ( scalar && *scalar == key_path_[parent.path_depth] &&
+                     !is_key_matched_[parent.path_depth] )
+                {
+                    /* for duplicate keys the first occurrence wins */
+                    is_key_matched_[parent.path_depth] = true;
+                    parent.next_role = ( parent.path_depth + 1 == key_path_.size() )
+                                       ? Role::TARGET : Role::PATH;
+                }
+                else
+                {
+                    parent.next_role = Role::SKIP;
+                }
+                return Role::SKIP;
+            }
+            parent.is_key_next = true;
+            next_path_depth_ = parent.path_depth + 1;
+            if ( parent.next_role == Role::TARGET )
+            {
+                is_found_ = true; // but not a sequence unless pushed as one
+            }
+            return parent.next_role;
+        }
+
+        /**
+         * @brief Role of a scalar or null node outside of elements. Stops when
+         * it is where the key path continues or ends, as the sequence cannot
+         * be found anymore.
+         */
+        Role onScalarNode(const std::string* scalar)
+        {
+            const Role role = nextRole(scalar);
+            if ( role == Role::PATH || role == Role::TARGET )
+            {
+                throw StopParsing();
+            }
+            return role;
+        }
+
+        /**
+         * @brief Tracks a container outside of elements.
+         *
+         * @return true if the container starts an element, false otherwise
+         */
+        bool pushFrame(Role role, bool is_map)
+        {
+            if ( role == Role::ELEMENT )
+            {
+                return true;
+            }
+            if ( role == Role::TARGET )
+            {
+                is_found_ = true;
+                is_sequence_ = !is_map;
+            }
+            if ( ( role == Role::TARGET && is_map ) ||
+                 ( role == Role::PATH && !is_map ) )
+            {
+                throw StopParsing();
+            }
+            stack_.push_back(Frame{role, next_path_depth_, is_map, true, Role::SKIP});
+            return false;
+        }
+
+        void onContainerEnd()
+        {
+            if ( element_depth_ > 0 )
+            {
+                handler_.onEnd();
+                element_depth_--;
+                endElementIfComplete();
+                return;
+            }
+            const Role role = stack_.back().role;
+            stack_.pop_back();
+            if ( role == Role::PATH || role == Role::TARGET )
+            {
+                /* the sequence was read or cannot appear anymore, since only
+                 * the first occurrence of each key is followed */
+                throw StopParsing();
+            }
+        }
+
+        void endElementIfComplete()
+        {
+            if ( element_depth_ == 0 && !handler_.onElementEnd(num_of_elements_++) )
+            {
+                throw StopParsing();
+            }
+        }
+
+        const std::vector<std::string>& key_path_;
+        ElementHandler& handler_;
+        std::vector<Frame> stack_;
+        std::vector<bool> is_key_matched_ = std::vector<bool>(key_path_.size(), false);
+        size_t next_path_depth_{0};
+        size_t element_depth_{0};
+        size_t num_of_elements_{0};
+        bool is_found_{false};
+        bool is_sequence_{false};
+        bool is_alias_found_{false};
+
+};
+
+bool streamSequence(std::istream& input,
+                    const std::vector<std::string>& key_path,
+                    ElementHandler& handler,
+                    ErrorSink* error_sink)
+{
+    SequenceEventHandler event_handler(key_path, handler);
+    try
+    {
+        YAML::Parser parser(input);
+        parser.HandleNextDocument(event_handler);
+    }
+    catch( const StopParsing& )
+    {
+    }
+    catch( const YAML::ParserException& e )
+    {
+        if ( error_sink )
+        {
+            const std::string detail(e.what());
+            error_sink->report(Error(ErrorCode::PARSE_ERROR, detail));
+        }
+        return false;
+    }
+
+    if ( handler.isFailed() )
+    {
+        return false;
+    }
+    std::string path;
+    for ( const std::string& key : key_path )
+    {
+        path += ( path.empty() ) ? key : "/" + key;
+    }
+    if ( event_handler.isAliasFound() )
+    {
+        if ( error_sink )
+        {
+            const std::string detail("Aliases are not supported when streaming " + path);
+            error_sink->report(Error(ErrorCode::OTHER, detail));
+        }
+        return false;
+    }
+    if ( !event_handler.isFound() )
+    {
+        if ( error_sink )
+        {
+            error_sink->report(Error(ErrorCode::MISSING_KEY, path));
+        }
+        return false;
+    }
+    if ( !event_handler.isSequence() )
+    {
+        if ( error_sink )
+        {
+            error_sink->report(Error(ErrorCode::BAD_VALUE_FOR_KEY, path));
+        }
+        return false;
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace yaml_common
+} // namespace kelo
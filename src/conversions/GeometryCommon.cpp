@@ -39,29 +39,224 @@
  ******************************************************************************/
 
 #include <yaml_common/conversions/GeometryCommon.h>
+#include <yaml_common/FieldSchema.h>
 #include <yaml_common/Parser2.h>
 
+namespace kelo
+{
+namespace yaml_common
+{
+
+namespace
+{
+
+/**
+ * @brief Quaternion form of TransformMatrix2D
+ */
+struct QuaternionTransform2D
+{
+    float x, y, qx, qy, qz, qw;
+};
+
+/**
+ * @brief Euler form of TransformMatrix3D
+ */
+struct EulerTransform3D
+{
+    float x, y, z, roll, pitch, yaw;
+};
+
+/**
+ * @brief Quaternion form of TransformMatrix3D
+ */
+struct QuaternionTransform3D
+{
+    float x, y, z, qx, qy, qz, qw;
+};
+
+} // namespace
+
+template <>
+struct schema<geometry_common::Box2D>
+{
+    using T = geometry_common::Box2D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("min_x", &T::min_x),
+            FieldSchema::field("max_x", &T::max_x),
+            FieldSchema::field("min_y", &T::min_y),
+            FieldSchema::field("max_y", &T::max_y));
+};
+constexpr decltype(schema<geometry_common::Box2D>::fields)
+    schema<geometry_common::Box2D>::fields;
+
+template <>
+struct schema<geometry_common::Box3D>
+{
+    using T = geometry_common::Box3D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("min_x", &T::min_x),
+            FieldSchema::field("max_x", &T::max_x),
+            FieldSchema::field("min_y", &T::min_y),
+            FieldSchema::field("max_y", &T::max_y),
+            FieldSchema::field("min_z", &T::min_z),
+            FieldSchema::field("max_z", &T::max_z));
+};
+constexpr decltype(schema<geometry_common::Box3D>::fields)
+    schema<geometry_common::Box3D>::fields;
+
+template <>
+struct schema<geometry_common::Point2D>
+{
+    using T = geometry_common::Point2D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y));
+};
+constexpr decltype(schema<geometry_common::Point2D>::fields)
+    schema<geometry_common::Point2D>::fields;
+
+template <>
+struct schema<geometry_common::Point3D>
+{
+    using T = geometry_common::Point3D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y),
+            FieldSchema::field("z", &T::z));
+};
+constexpr decltype(schema<geometry_common::Point3D>::fields)
+    schema<geometry_common::Point3D>::fields;
+
+template <>
+struct schema<geometry_common::XYTheta>
+{
+    using T = geometry_common::XYTheta;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y),
+            FieldSchema::field("theta", &T::theta));
+};
+constexpr decltype(schema<geometry_common::XYTheta>::fields)
+    schema<geometry_common::XYTheta>::fields;
+
+/* only used to encode and emit; decoding and validation go through XYTheta,
+ * since Pose2D clips the angle on construction */
+template <>
+struct schema<geometry_common::Pose2D>
+{
+    using T = geometry_common::Pose2D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y),
+            FieldSchema::field("theta", &T::theta));
+};
+constexpr decltype(schema<geometry_common::Pose2D>::fields)
+    schema<geometry_common::Pose2D>::fields;
+
+template <>
+struct schema<geometry_common::Circle>
+{
+    using T = geometry_common::Circle;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y),
+            FieldSchema::field("r", &T::r));
+};
+constexpr decltype(schema<geometry_common::Circle>::fields)
+    schema<geometry_common::Circle>::fields;
+
+template <>
+struct schema<QuaternionTransform2D>
+{
+    using T = QuaternionTransform2D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y),
+            FieldSchema::field("qx", &T::qx),
+            FieldSchema::field("qy", &T::qy),
+            FieldSchema::field("qz", &T::qz),
+            FieldSchema::field("qw", &T::qw));
+};
+constexpr decltype(schema<QuaternionTransform2D>::fields)
+    schema<QuaternionTransform2D>::fields;
+
+template <>
+struct schema<EulerTransform3D>
+{
+    using T = EulerTransform3D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y),
+            FieldSchema::field("z", &T::z),
+            FieldSchema::field("roll", &T::roll),
+            FieldSchema::field("pitch", &T::pitch),
+            FieldSchema::field("yaw", &T::yaw));
+};
+constexpr decltype(schema<EulerTransform3D>::fields)
+    schema<EulerTransform3D>::fields;
+
+template <>
+struct schema<QuaternionTransform3D>
+{
+    using T = QuaternionTransform3D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("x", &T::x),
+            FieldSchema::field("y", &T::y),
+            FieldSchema::field("z", &T::z),
+            FieldSchema::field("qx", &T::qx),
+            FieldSchema::field("qy", &T::qy),
+            FieldSchema::field("qz", &T::qz),
+            FieldSchema::field("qw", &T::qw));
+};
+constexpr decltype(schema<QuaternionTransform3D>::fields)
+    schema<QuaternionTransform3D>::fields;
+
+template <>
+struct schema<geometry_common::LineSegment2D>
+{
+    using T = geometry_common::LineSegment2D;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("start", &T::start),
+            FieldSchema::field("end", &T::end));
+};
+constexpr decltype(schema<geometry_common::LineSegment2D>::fields)
+    schema<geometry_common::LineSegment2D>::fields;
+
+template <>
+struct schema<PointCloudProjectorConfig>
+{
+    using T = PointCloudProjectorConfig;
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::optionalField("transform", &T::tf_mat),
+            FieldSchema::field("angle_min", &T::angle_min),
+            FieldSchema::field("angle_max", &T::angle_max),
+            FieldSchema::field("passthrough_min_z", &T::passthrough_min_z),
+            FieldSchema::field("passthrough_max_z", &T::passthrough_max_z),
+            FieldSchema::field("radial_dist_min", &T::radial_dist_min),
+            FieldSchema::field("radial_dist_max", &T::radial_dist_max),
+            FieldSchema::field("angle_increment", &T::angle_increment));
+};
+constexpr decltype(schema<PointCloudProjectorConfig>::fields)
+    schema<PointCloudProjectorConfig>::fields;
+
+} // namespace yaml_common
+} // namespace kelo
+
 namespace YAML
 {
 
+using kelo::yaml_common::FieldSchema;
+
 Node convert<kelo::geometry_common::Box2D>::encode(
         const kelo::geometry_common::Box2D& box)
 {
-    Node node;
-    node["min_x"] = box.min_x;
-    node["max_x"] = box.max_x;
-    node["min_y"] = box.min_y;
-    node["max_y"] = box.max_y;
-    return node;
+    return FieldSchema::encode(box);
 }
 
 bool convert<kelo::geometry_common::Box2D>::decode(
         const Node& node, kelo::geometry_common::Box2D& box)
 {
-    return ( kelo::yaml_common::Parser2::read<float>(node, "min_x", box.min_x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "max_x", box.max_x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "min_y", box.min_y) &&
-             kelo::yaml_common::Parser2::read<float>(node, "max_y", box.max_y) );
+    return FieldSchema::decode(node, box);
 }
 
 
@@ -69,25 +264,13 @@ bool convert<kelo::geometry_common::Box2D>::decode(
 Node convert<kelo::geometry_common::Box3D>::encode(
         const kelo::geometry_common::Box3D& box)
 {
-    Node node;
-    node["min_x"] = box.min_x;
-    node["max_x"] = box.max_x;
-    node["min_y"] = box.min_y;
-    node["max_y"] = box.max_y;
-    node["min_z"] = box.min_z;
-    node["max_z"] = box.max_z;
-    return node;
+    return FieldSchema::encode(box);
 }
 
 bool convert<kelo::geometry_common::Box3D>::decode(
         const Node& node, kelo::geometry_common::Box3D& box)
 {
-    return ( kelo::yaml_common::Parser2::read<float>(node, "min_x", box.min_x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "max_x", box.max_x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "min_y", box.min_y) &&
-             kelo::yaml_common::Parser2::read<float>(node, "max_y", box.max_y) &&
-             kelo::yaml_common::Parser2::read<float>(node, "min_z", box.min_z) &&
-             kelo::yaml_common::Parser2::read<float>(node, "max_z", box.max_z) );
+    return FieldSchema::decode(node, box);
 }
 
 
@@ -95,17 +278,13 @@ bool convert<kelo::geometry_common::Box3D>::decode(
 Node convert<kelo::geometry_common::Point2D>::encode(
         const kelo::geometry_common::Point2D& pt)
 {
-    Node node;
-    node["x"] = pt.x;
-    node["y"] = pt.y;
-    return node;
+    return FieldSchema::encode(pt);
 }
 
 bool convert<kelo::geometry_common::Point2D>::decode(
         const Node& node, kelo::geometry_common::Point2D& pt)
 {
-    return ( kelo::yaml_common::Parser2::read<float>(node, "x", pt.x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "y", pt.y) );
+    return FieldSchema::decode(node, pt);
 }
 
 
@@ -113,19 +292,13 @@ bool convert<kelo::geometry_common::Point2D>::decode(
 Node convert<kelo::geometry_common::Point3D>::encode(
         const kelo::geometry_common::Point3D& pt)
 {
-    Node node;
-    node["x"] = pt.x;
-    node["y"] = pt.y;
-    node["z"] = pt.z;
-    return node;
+    return FieldSchema::encode(pt);
 }
 
 bool convert<kelo::geometry_common::Point3D>::decode(
         const Node& node, kelo::geometry_common::Point3D& pt)
 {
-    return ( kelo::yaml_common::Parser2::read<float>(node, "x", pt.x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "y", pt.y) &&
-             kelo::yaml_common::Parser2::read<float>(node, "z", pt.z) );
+    return FieldSchema::decode(node, pt);
 }
 
 
@@ -133,19 +306,13 @@ bool convert<kelo::geometry_common::Point3D>::decode(
 Node convert<kelo::geometry_common::XYTheta>::encode(
         const kelo::geometry_common::XYTheta& x_y_theta)
 {
-    Node node;
-    node["x"] = x_y_theta.x;
-    node["y"] = x_y_theta.y;
-    node["theta"] = x_y_theta.theta;
-    return node;
+    return FieldSchema::encode(x_y_theta);
 }
 
 bool convert<kelo::geometry_common::XYTheta>::decode(
         const Node& node, kelo::geometry_common::XYTheta& x_y_theta)
 {
-    return ( kelo::yaml_common::Parser2::read<float>(node, "x", x_y_theta.x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "y", x_y_theta.y) &&
-             kelo::yaml_common::Parser2::read<float>(node, "theta", x_y_theta.theta) );
+    return FieldSchema::decode(node, x_y_theta);
 }
 
 
@@ -153,19 +320,17 @@ bool convert<kelo::geometry_common::XYTheta>::decode(
 Node convert<kelo::geometry_common::Pose2D>::encode(
         const kelo::geometry_common::Pose2D& pose)
 {
-    Node node;
-    node["x"] = pose.x;
-    node["y"] = pose.y;
-    node["theta"] = pose.theta;
-    return node;
+    return FieldSchema::encode(pose);
 }
 
 bool convert<kelo::geometry_common::Pose2D>::decode(
         const Node& node, kelo::geometry_common::Pose2D& pose)
 {
+    kelo::yaml_common::ErrorSink* error_sink =
+        kelo::yaml_common::Parser2::activeErrorSink();
     kelo::geometry_common::XYTheta temp_value;
     if ( !kelo::yaml_common::Parser2::read<kelo::geometry_common::XYTheta>(
-                node, temp_value, true) )
+                node, temp_value, error_sink) )
     {
         return false;
     }
@@ -178,19 +343,13 @@ bool convert<kelo::geometry_common::Pose2D>::decode(
 Node convert<kelo::geometry_common::Circle>::encode(
         const kelo::geometry_common::Circle& circle)
 {
-    Node node;
-    node["x"] = circle.x;
-    node["y"] = circle.y;
-    node["r"] = circle.r;
-    return node;
+    return FieldSchema::encode(circle);
 }
 
 bool convert<kelo::geometry_common::Circle>::decode(
         const Node& node, kelo::geometry_common::Circle& circle)
 {
-    return ( kelo::yaml_common::Parser2::read<float>(node, "x", circle.x) &&
-             kelo::yaml_common::Parser2::read<float>(node, "y", circle.y) &&
-             kelo::yaml_common::Parser2::read<float>(node, "r", circle.r) );
+    return FieldSchema::decode(node, circle);
 }
 
 
@@ -198,36 +357,37 @@ bool convert<kelo::geometry_common::Circle>::decode(
 Node convert<kelo::geometry_common::TransformMatrix2D>::encode(
         const kelo::geometry_common::TransformMatrix2D& tf_mat)
 {
-    Node node;
-    node["x"] = tf_mat.x();
-    node["y"] = tf_mat.y();
-    node["theta"] = tf_mat.theta();
-    return node;
+    return FieldSchema::encode(kelo::geometry_common::XYTheta(
+                tf_mat.x(), tf_mat.y(), tf_mat.theta()));
 }
 
 bool convert<kelo::geometry_common::TransformMatrix2D>::decode(
         const Node& node, kelo::geometry_common::TransformMatrix2D& tf_mat)
 {
-    std::vector<std::string> keys{"x", "y", "theta"};
-    std::vector<std::string> keys_quat{"x", "y", "qx", "qy", "qz", "qw"};
-    std::vector<float> values;
+    kelo::yaml_common::ErrorSink* error_sink =
+        kelo::yaml_common::Parser2::activeErrorSink();
 
-    if ( kelo::yaml_common::Parser2::readFloats(node, keys, values, false) )
+    kelo::geometry_common::XYTheta euler;
+    if ( FieldSchema::decode(node, euler, nullptr) )
     {
-        tf_mat.update(values[0], values[1], values[2]);
+        tf_mat.update(euler.x, euler.y, euler.theta);
         return true;
     }
 
-    values.clear();
-    if ( kelo::yaml_common::Parser2::readFloats(node, keys_quat, values, false) )
+    kelo::yaml_common::QuaternionTransform2D quat;
+    if ( FieldSchema::decode(node, quat, nullptr) )
     {
-        tf_mat.update(values[0], values[1], values[2],
-                      values[3], values[4], values[5]);
+        tf_mat.update(quat.x, quat.y, quat.qx, quat.qy, quat.qz, quat.qw);
         return true;
     }
 
-    std::cout << "Could not read TransformMatrix2D with either euler or quaternion format."
-              << std::endl;
+    if ( error_sink != nullptr )
+    {
+        const std::string detail(
+                "Could not read TransformMatrix2D with either euler or quaternion format.");
+        error_sink->report(kelo::yaml_common::Error(
+                    kelo::yaml_common::ErrorCode::OTHER, detail));
+    }
     return false;
 }
 
@@ -236,40 +396,40 @@ bool convert<kelo::geometry_common::TransformMatrix2D>::decode(
 Node convert<kelo::geometry_common::TransformMatrix3D>::encode(
         const kelo::geometry_common::TransformMatrix3D& tf_mat)
 {
-    Node node;
-    node["x"] = tf_mat.x();
-    node["y"] = tf_mat.y();
-    node["z"] = tf_mat.z();
-    node["roll"] = tf_mat.roll();
-    node["pitch"] = tf_mat.pitch();
-    node["yaw"] = tf_mat.yaw();
-    return node;
+    return FieldSchema::encode(kelo::yaml_common::EulerTransform3D{
+                tf_mat.x(), tf_mat.y(), tf_mat.z(),
+                tf_mat.roll(), tf_mat.pitch(), tf_mat.yaw()});
 }
 
 bool convert<kelo::geometry_common::TransformMatrix3D>::decode(
         const Node& node, kelo::geometry_common::TransformMatrix3D& tf_mat)
 {
-    std::vector<std::string> keys{"x", "y", "z", "roll", "pitch", "yaw"};
-    std::vector<std::string> keys_quat{"x", "y", "z", "qx", "qy", "qz", "qw"};
-    std::vector<float> values;
+    kelo::yaml_common::ErrorSink* error_sink =
+        kelo::yaml_common::Parser2::activeErrorSink();
 
-    if ( kelo::yaml_common::Parser2::readFloats(node, keys, values, false) )
+    kelo::yaml_common::EulerTransform3D euler;
+    if ( FieldSchema::decode(node, euler, nullptr) )
     {
-        tf_mat.update(values[0], values[1], values[2],
-                      values[3], values[4], values[5]);
+        tf_mat.update(euler.x, euler.y, euler.z,
+                      euler.roll, euler.pitch, euler.yaw);
         return true;
     }
 
-    values.clear();
-    if ( kelo::yaml_common::Parser2::readFloats(node, keys_quat, values, false) )
+    kelo::yaml_common::QuaternionTransform3D quat;
+    if ( FieldSchema::decode(node, quat, nullptr) )
     {
-        tf_mat.update(values[0], values[1], values[2],
-                      values[3], values[4], values[5], values[6]);
+        tf_mat.update(quat.x, quat.y, quat.z,
+                      quat.qx, quat.qy, quat.qz, quat.qw);
         return true;
     }
 
-    std::cout << "Could not read TransformMatrix3D with either euler or quaternion format."
-              << std::endl;
+    if ( error_sink != nullptr )
+    {
+        const std::string detail(
+                "Could not read TransformMatrix3D with either euler or quaternion format.");
+        error_sink->report(kelo::yaml_common::Error(
+                    kelo::yaml_common::ErrorCode::OTHER, detail));
+    }
     return false;
 }
 
@@ -278,23 +438,15 @@ bool convert<kelo::geometry_common::TransformMatrix3D>::decode(
 Node convert<kelo::geometry_common::LineSegment2D>::encode(
         const kelo::geometry_common::LineSegment2D& line_segment)
 {
-    Node node;
-    node["start"] = line_segment.start;
-    node["end"] = line_segment.end;
-    return node;
+    return FieldSchema::encode(line_segment);
 }
 
 bool convert<kelo::geometry_common::LineSegment2D>::decode(
         const Node& node, kelo::geometry_common::LineSegment2D& line_segment)
 {
-    return ( kelo::yaml_common::Parser2::read<kelo::geometry_common::Point2D>(
-                 node, "start", line_segment.start) &&
-             kelo::yaml_common::Parser2::read<kelo::geometry_common::Point2D>(
-                 node, "end", line_segment.end) );
+    return FieldSchema::decode(node, line_segment);
 }
 
-
-
 Node convert<kelo::geometry_common::Polyline2D>::encode(
         const kelo::geometry_common::Polyline2D& polyline)
 {
@@ -309,8 +461,10 @@ Node convert<kelo::geometry_common::Polyline2D>::encode(
 bool convert<kelo::geometry_common::Polyline2D>::decode(
         const Node& node, kelo::geometry_common::Polyline2D& polyline)
 {
+    kelo::yaml_common::ErrorSink* error_sink =
+        kelo::yaml_common::Parser2::activeErrorSink();
     return kelo::yaml_common::Parser2::read<std::vector<kelo::geometry_common::Point2D>>(
-            node, polyline.vertices);
+            node, polyline.vertices, error_sink);
 }
 
 
@@ -329,8 +483,10 @@ Node convert<kelo::geometry_common::Polygon2D>::encode(
 bool convert<kelo::geometry_common::Polygon2D>::decode(
         const Node& node, kelo::geometry_common::Polygon2D& polygon)
 {
+    kelo::yaml_common::ErrorSink* error_sink =
+        kelo::yaml_common::Parser2::activeErrorSink();
     return kelo::yaml_common::Parser2::read<std::vector<kelo::geometry_common::Point2D>>(
-            node, polygon.vertices);
+            node, polygon.vertices, error_sink);
 }
 
 
@@ -338,38 +494,181 @@ bool convert<kelo::geometry_common::Polygon2D>::decode(
 Node convert<kelo::PointCloudProjectorConfig>::encode(
         const kelo::PointCloudProjectorConfig& config)
 {
-    Node node;
-    node["transform"] = config.tf_mat;
-    node["angle_min"] = config.angle_min;
-    node["angle_max"] = config.angle_max;
-    node["passthrough_min_z"] = config.passthrough_min_z;
-    node["passthrough_max_z"] = config.passthrough_max_z;
-    node["radial_dist_min"] = config.radial_dist_min;
-    node["radial_dist_max"] = config.radial_dist_max;
-    node["angle_increment"] = config.angle_increment;
-    return node;
+    return FieldSchema::encode(config);
 }
 
 bool convert<kelo::PointCloudProjectorConfig>::decode(
         const Node& node, kelo::PointCloudProjectorConfig& config)
 {
-    kelo::yaml_common::Parser2::read<kelo::geometry_common::TransformMatrix3D>(
-            node, "transform", config.tf_mat, false); // optional
-    return ( kelo::yaml_common::Parser2::read<float>(
-                 node, "angle_min", config.angle_min) &&
-             kelo::yaml_common::Parser2::read<float>(
-                 node, "angle_max", config.angle_max) &&
-             kelo::yaml_common::Parser2::read<float>(
-                 node, "passthrough_min_z", config.passthrough_min_z) &&
-             kelo::yaml_common::Parser2::read<float>(
-                 node, "passthrough_max_z", config.passthrough_max_z) &&
-             kelo::yaml_common::Parser2::read<float>(
-                 node, "radial_dist_min", config.radial_dist_min) &&
-             kelo::yaml_common::Parser2::read<float>(
-                 node, "radial_dist_max", config.radial_dist_max) &&
-             kelo::yaml_common::Parser2::read<float>(
-                 node, "angle_increment", config.angle_increment) );
-    return true;
+    return FieldSchema::decode(node, config);
+}
+
+
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Box2D& box)
+{
+    FieldSchema::emit(out, box);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Box3D& box)
+{
+    FieldSchema::emit(out, box);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Point2D& pt)
+{
+    FieldSchema::emit(out, pt);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Point3D& pt)
+{
+    FieldSchema::emit(out, pt);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::XYTheta& x_y_theta)
+{
+    FieldSchema::emit(out, x_y_theta);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Pose2D& pose)
+{
+    FieldSchema::emit(out, pose);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Circle& circle)
+{
+    FieldSchema::emit(out, circle);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::TransformMatrix2D& tf_mat)
+{
+    FieldSchema::emit(out, kelo::geometry_common::XYTheta(
+                tf_mat.x(), tf_mat.y(), tf_mat.theta()));
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::TransformMatrix3D& tf_mat)
+{
+    FieldSchema::emit(out, kelo::yaml_common::EulerTransform3D{
+                tf_mat.x(), tf_mat.y(), tf_mat.z(),
+                tf_mat.roll(), tf_mat.pitch(), tf_mat.yaw()});
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::LineSegment2D& line_segment)
+{
+    FieldSchema::emit(out, line_segment);
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Polyline2D& polyline)
+{
+    out << BeginSeq;
+    for ( size_t i = 0; i < polyline.size(); i++ )
+    {
+        out << polyline[i];
+    }
+    out << EndSeq;
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::geometry_common::Polygon2D& polygon)
+{
+    out << BeginSeq;
+    for ( size_t i = 0; i < polygon.size(); i++ )
+    {
+        out << polygon[i];
+    }
+    out << EndSeq;
+    return out;
+}
+
+Emitter& operator << (Emitter& out, const kelo::PointCloudProjectorConfig& config)
+{
+    FieldSchema::emit(out, config);
+    return out;
 }
 
 } // namespace YAML
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+bool check<geometry_common::Box2D>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::Box2D>(node);
+}
+
+bool check<geometry_common::Box3D>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::Box3D>(node);
+}
+
+bool check<geometry_common::Point2D>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::Point2D>(node);
+}
+
+bool check<geometry_common::Point3D>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::Point3D>(node);
+}
+
+bool check<geometry_common::XYTheta>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::XYTheta>(node);
+}
+
+bool check<geometry_common::Pose2D>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::XYTheta>(node);
+}
+
+bool check<geometry_common::Circle>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::Circle>(node);
+}
+
+bool check<geometry_common::TransformMatrix2D>::validate(const YAML::Node& node)
+{
+    return ( FieldSchema::validate<geometry_common::XYTheta>(node) ||
+             FieldSchema::validate<QuaternionTransform2D>(node) );
+}
+
+bool check<geometry_common::TransformMatrix3D>::validate(const YAML::Node& node)
+{
+    return ( FieldSchema::validate<EulerTransform3D>(node) ||
+             FieldSchema::validate<QuaternionTransform3D>(node) );
+}
+
+bool check<geometry_common::LineSegment2D>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<geometry_common::LineSegment2D>(node);
+}
+
+bool check<geometry_common::Polyline2D>::validate(const YAML::Node& node)
+{
+    return Parser2::is<std::vector<geometry_common::Point2D>>(node);
+}
+
+bool check<geometry_common::Polygon2D>::validate(const YAML::Node& node)
+{
+    return Parser2::is<std::vector<geometry_common::Point2D>>(node);
+}
+
+bool check<PointCloudProjectorConfig>::validate(const YAML::Node& node)
+{
+    return FieldSchema::validate<PointCloudProjectorConfig>(node);
+}
+
+} // namespace yaml_common
+} // namespace kelo
@@ -0,0 +1,153 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ConfigWatcher.h>
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::BufferedErrorSink;
+using kelo::yaml_common::ConfigWatcher;
+using kelo::yaml_common::ErrorCode;
+using kelo::yaml_common::FrozenTree;
+
+/**
+ * @brief Wait until the watcher published `version`, at most for a few
+ * seconds
+ */
+static bool waitForVersion(const ConfigWatcher& watcher, uint64_t version)
+{
+    for ( size_t i = 0; i < 500 && watcher.version() < version; i++ )
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return ( watcher.version() >= version );
+}
+
+static int speed(const ConfigWatcher& watcher)
+{
+    return Parser::get<int>(watcher.current()->root(), "speed", -1);
+}
+
+TEST(ConfigWatcherTest, reloadOnChange)
+{
+    const std::string file_path = testing::TempDir() + "config_watcher_test.yaml";
+    std::ofstream(file_path) << "speed: 1\n";
+
+    BufferedErrorSink errors;
+    ConfigWatcher watcher(file_path, &errors);
+    EXPECT_EQ(watcher.current(), nullptr);
+    size_t num_of_callbacks = 0;
+    watcher.setCallback([&num_of_callbacks](const std::shared_ptr<const FrozenTree>&)
+                        { num_of_callbacks++; });
+    ASSERT_TRUE(watcher.start());
+    EXPECT_FALSE(watcher.start());
+    EXPECT_EQ(watcher.version(), 1u);
+    EXPECT_EQ(speed(watcher), 1);
+    const std::shared_ptr<const FrozenTree> first = watcher.current();
+
+    /* written in place */
+    std::ofstream(file_path) << "speed: 2\n";
+    ASSERT_TRUE(waitForVersion(watcher, 2));
+    EXPECT_EQ(speed(watcher), 2);
+
+    /* replaced by renaming */
+    const std::string temp_path = file_path + ".tmp";
+    std::ofstream(temp_path) << "speed: 3\n";
+    ASSERT_EQ(std::rename(temp_path.c_str(), file_path.c_str()), 0);
+    ASSERT_TRUE(waitForVersion(watcher, 3));
+    EXPECT_EQ(speed(watcher), 3);
+
+    /* an invalid file keeps the current tree */
+    std::ofstream(file_path) << "speed: [3\n";
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+                ConfigWatcher::DEBOUNCE_MS * 10));
+    EXPECT_EQ(watcher.version(), 3u);
+    EXPECT_EQ(speed(watcher), 3);
+    EXPECT_EQ(errors.codes(), std::vector<ErrorCode>({ErrorCode::PARSE_ERROR}));
+
+    /* other files in the directory are ignored */
+    std::ofstream(testing::TempDir() + "config_watcher_other.yaml") << "a: 1\n";
+
+    /* old trees stay valid while they are held */
+    EXPECT_EQ(Parser::get<int>(first->root(), "speed", -1), 1);
+
+    watcher.stop();
+    std::ofstream(file_path) << "speed: 5\n";
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+                ConfigWatcher::DEBOUNCE_MS * 10));
+    EXPECT_EQ(watcher.version(), 3u);
+    EXPECT_EQ(num_of_callbacks, 3u);
+
+    EXPECT_TRUE(watcher.reload());
+    EXPECT_EQ(speed(watcher), 5);
+}
+
+TEST(ConfigWatcherTest, layers)
+{
+    const std::string defaults_path = testing::TempDir() + "config_watcher_defaults.yaml";
+    const std::string site_path = testing::TempDir() + "config_watcher_site.yaml";
+    std::ofstream(defaults_path) << "speed: 1\nname: robot\n";
+    std::ofstream(site_path) << "speed: 2\n";
+
+    ConfigWatcher watcher({defaults_path, site_path});
+    ASSERT_TRUE(watcher.start());
+    EXPECT_EQ(speed(watcher), 2);
+    EXPECT_EQ(Parser::get<std::string>(watcher.current()->root(), "name", ""), "robot");
+
+    std::ofstream(defaults_path) << "speed: 1\nname: other\n";
+    ASSERT_TRUE(waitForVersion(watcher, 2));
+    EXPECT_EQ(speed(watcher), 2);
+    EXPECT_EQ(Parser::get<std::string>(watcher.current()->root(), "name", ""), "other");
+
+    ConfigWatcher missing(testing::TempDir() + "config_watcher_missing.yaml", nullptr);
+    EXPECT_FALSE(missing.start());
+    EXPECT_EQ(missing.current(), nullptr);
+}
+
+TEST(ConfigWatcherTest, concurrentReaders)
+{
+    const std::string file_path = testing::TempDir() + "config_watcher_readers.yaml";
+    std::ofstream(file_path) << "speed: 1\n";
+    /* reloaded explicitly; watching would also reload truncated files */
+    ConfigWatcher watcher(file_path);
+    ASSERT_TRUE(watcher.reload());
+
+    std::atomic<bool> is_done{false};
+    std::atomic<size_t> num_of_failures{0};
+    std::vector<std::thread> readers;
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        readers.emplace_back([&]()
+        {
+            while ( !is_done )
+            {
+                const std::shared_ptr<const FrozenTree> tree = watcher.current();
+                if ( tree == nullptr ||
+                     Parser::get<int>(tree->root(), "speed", -1) < 1 )
+                {
+                    num_of_failures++;
+                }
+            }
+        });
+    }
+    for ( int i = 2; i <= 50; i++ )
+    {
+        std::ofstream(file_path) << "speed: " << i << "\n";
+        ASSERT_TRUE(watcher.reload());
+    }
+    is_done = true;
+    for ( std::thread& reader : readers )
+    {
+        reader.join();
+    }
+    EXPECT_EQ(num_of_failures.load(), 0u);
+    EXPECT_EQ(speed(watcher), 50);
+}
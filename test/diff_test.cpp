@@ -0,0 +1,169 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ChangeNotifier.h>
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::ChangeNotifier;
+using kelo::yaml_common::ChangeType;
+using kelo::yaml_common::FrozenNode;
+using kelo::yaml_common::FrozenTree;
+using kelo::yaml_common::PathChange;
+
+/**
+ * @brief Diff with both overloads, check that they agree and return the
+ * changes as "+path", "-path" and "~path"
+ */
+static std::vector<std::string> diff(const YAML::Node& old_node, const YAML::Node& new_node)
+{
+    const auto toStrings = [](const std::vector<PathChange>& changes)
+    {
+        std::vector<std::string> strings;
+        for ( const PathChange& change : changes )
+        {
+            const char type = ( change.type == ChangeType::ADDED ) ? '+' :
+                              ( change.type == ChangeType::REMOVED ) ? '-' : '~';
+            strings.push_back(type + change.path);
+        }
+        return strings;
+    };
+
+    std::vector<PathChange> changes;
+    Parser::diffYAML(old_node, new_node, changes);
+
+    std::vector<PathChange> frozen_changes;
+    const FrozenTree old_tree(old_node);
+    const FrozenTree new_tree(new_node);
+    Parser::diffYAML(old_tree.root(), new_tree.root(), frozen_changes);
+
+    EXPECT_EQ(toStrings(changes), toStrings(frozen_changes));
+    return toStrings(changes);
+}
+
+static std::vector<std::string> diff(const std::string& old_yaml, const std::string& new_yaml)
+{
+    return diff(YAML::Load(old_yaml), YAML::Load(new_yaml));
+}
+
+TEST(DiffTest, identical)
+{
+    const std::string yaml = "{a: 1, b: [1, {c: x}], d: ~, !!str e: !foo 1}";
+    EXPECT_TRUE(diff(yaml, yaml).empty());
+
+    const YAML::Node node = YAML::Load(yaml);
+    EXPECT_TRUE(diff(node, node).empty());
+
+    /* only order and style differ */
+    EXPECT_TRUE(diff("{a: 1, b: {c: 2, d: 3}}", "b:\n  d: 3\n  c: 2\na: 1\n").empty());
+
+    /* a quoted scalar has a different tag than a plain one */
+    EXPECT_EQ(diff("{a: 1}", "{a: '1'}"), (std::vector<std::string>{"~a"}));
+}
+
+TEST(DiffTest, maps)
+{
+    EXPECT_EQ(diff("{a: 1, b: 2, c: 3}", "{d: 4, c: 3, a: 5}"),
+              (std::vector<std::string>{"~a", "-b", "+d"}));
+    EXPECT_EQ(diff("{a: {b: {c: 1, d: 2}}, e: 1}", "{a: {b: {c: 1, d: 3}}, e: 1}"),
+              (std::vector<std::string>{"~a/b/d"}));
+
+    /* only the first occurrence of a duplicate key counts, as with node[key] */
+    EXPECT_EQ(diff("{a: 1, a: 2}", "{a: 1, a: 3}"), (std::vector<std::string>{}));
+    EXPECT_EQ(diff("{a: 1, a: 2}", "{a: 2}"), (std::vector<std::string>{"~a"}));
+
+    /* non scalar keys compare the map as a whole */
+    EXPECT_EQ(diff("{[a]: 1}", "{[a]: 2}"), (std::vector<std::string>{"~"}));
+}
+
+TEST(DiffTest, sequences)
+{
+    EXPECT_EQ(diff("{v: [1, 2, 3]}", "{v: [1, 5, 3, 4, 6]}"),
+              (std::vector<std::string>{"~v/1", "+v/3", "+v/4"}));
+    EXPECT_EQ(diff("{v: [1, 2, 3]}", "{v: [1]}"),
+              (std::vector<std::string>{"-v/1", "-v/2"}));
+    EXPECT_EQ(diff("[{a: 1}, {a: 1}]", "[{a: 1}, {a: 2}]"),
+              (std::vector<std::string>{"~1/a"}));
+}
+
+TEST(DiffTest, types)
+{
+    EXPECT_EQ(diff("{a: [1], b: {c: 1}, d: 1, e: ~}", "{a: {0: 1}, b: [1], d: [1], e: 1}"),
+              (std::vector<std::string>{"~a", "~b", "~d", "~e"}));
+    EXPECT_EQ(diff("{a: !foo 1, b: !foo {c: 1}}", "{a: !bar 1, b: !bar {c: 1}}"),
+              (std::vector<std::string>{"~a", "~b"}));
+    EXPECT_EQ(diff("1", "2"), (std::vector<std::string>{"~"}));
+
+    const YAML::Node null_node;
+    const YAML::Node undefined = null_node["missing"];
+    EXPECT_EQ(diff(undefined, YAML::Load("{a: 1}")), (std::vector<std::string>{"+"}));
+    EXPECT_EQ(diff(YAML::Load("{a: 1}"), undefined), (std::vector<std::string>{"-"}));
+    EXPECT_EQ(diff(undefined, undefined), (std::vector<std::string>{}));
+    EXPECT_EQ(diff(null_node, YAML::Load("{a: 1}")), (std::vector<std::string>{"~"}));
+}
+
+TEST(DiffTest, changeNotifierIsAffected)
+{
+    EXPECT_TRUE(ChangeNotifier::isAffected("", "a/b"));
+    EXPECT_TRUE(ChangeNotifier::isAffected("a", "a/b"));
+    EXPECT_TRUE(ChangeNotifier::isAffected("a/b", "a/b"));
+    EXPECT_TRUE(ChangeNotifier::isAffected("a/b/c", "a/b"));
+    EXPECT_TRUE(ChangeNotifier::isAffected("a/b", ""));
+    EXPECT_FALSE(ChangeNotifier::isAffected("a", "ab"));
+    EXPECT_FALSE(ChangeNotifier::isAffected("a/b", "a/c"));
+    EXPECT_FALSE(ChangeNotifier::isAffected("ab/c", "a"));
+}
+
+TEST(DiffTest, changeNotifier)
+{
+    ChangeNotifier notifier;
+    std::vector<std::string> all;
+    std::vector<std::string> controller;
+    std::vector<std::string> max_vel;
+    const auto collect = [](std::vector<std::string>& paths)
+    {
+        return [&paths](const std::vector<PathChange>& changes)
+        {
+            for ( const PathChange& change : changes )
+            {
+                paths.push_back(change.path);
+            }
+        };
+    };
+    notifier.subscribe("", collect(all));
+    notifier.subscribe("controller", collect(controller));
+    const size_t id = notifier.subscribe("controller/max_vel", collect(max_vel));
+
+    const auto update = [&notifier](const std::string& yaml)
+    {
+        notifier.update(std::make_shared<const FrozenTree>(YAML::Load(yaml)));
+    };
+
+    update("{controller: {max_vel: 1, max_acc: 2}, sensors: [a]}");
+    EXPECT_EQ(all, (std::vector<std::string>{""}));
+    EXPECT_EQ(controller, (std::vector<std::string>{""}));
+    EXPECT_EQ(max_vel, (std::vector<std::string>{""}));
+    ASSERT_NE(notifier.current(), nullptr);
+    EXPECT_EQ(notifier.current()->root().find("sensors")[0].scalar(), "a");
+
+    update("{controller: {max_vel: 1, max_acc: 3}, sensors: [a, b]}");
+    EXPECT_EQ(all, (std::vector<std::string>{"", "controller/max_acc", "sensors/1"}));
+    EXPECT_EQ(controller, (std::vector<std::string>{"", "controller/max_acc"}));
+    EXPECT_EQ(max_vel, (std::vector<std::string>{""}));
+
+    /* no change, no call */
+    update("{controller: {max_vel: 1, max_acc: 3}, sensors: [a, b]}");
+    EXPECT_EQ(all.size(), 3u);
+
+    EXPECT_TRUE(notifier.unsubscribe(id));
+    EXPECT_FALSE(notifier.unsubscribe(id));
+    update("{controller: 5, sensors: [a, b]}");
+    EXPECT_EQ(controller, (std::vector<std::string>{"", "controller/max_acc", "controller"}));
+    EXPECT_EQ(max_vel, (std::vector<std::string>{""}));
+}
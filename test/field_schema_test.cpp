@@ -0,0 +1,144 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/FieldSchema.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::BufferedErrorSink;
+using kelo::yaml_common::ErrorCode;
+using kelo::yaml_common::FieldSchema;
+
+struct Wheel
+{
+    std::string name;
+    float radius{0.0f};
+    std::vector<int> ids;
+    double offset{-1.0};
+};
+
+namespace kelo
+{
+namespace yaml_common
+{
+
+template <>
+struct schema<Wheel>
+{
+    static constexpr auto fields = FieldSchema::fields(
+            FieldSchema::field("name", &Wheel::name),
+            FieldSchema::field("radius", &Wheel::radius),
+            FieldSchema::field("ids", &Wheel::ids),
+            FieldSchema::optionalField("offset", &Wheel::offset));
+};
+constexpr decltype(schema<Wheel>::fields) schema<Wheel>::fields;
+
+template <>
+struct check<Wheel>
+{
+    static bool validate(const YAML::Node& node)
+    {
+        return FieldSchema::validate<Wheel>(node);
+    }
+};
+
+} // namespace yaml_common
+} // namespace kelo
+
+namespace YAML
+{
+
+template <>
+struct convert<Wheel>
+{
+    static Node encode(const Wheel& wheel)
+    {
+        return FieldSchema::encode(wheel);
+    }
+
+    static bool decode(const Node& node, Wheel& wheel)
+    {
+        return FieldSchema::decode(node, wheel);
+    }
+};
+
+} // namespace YAML
+
+static_assert(FieldSchema::hash("") == 14695981039346656037ULL, "FNV-1a offset basis");
+static_assert(FieldSchema::hash("a") == 0xaf63dc4c8601ec8cULL, "FNV-1a of \"a\"");
+
+TEST(FieldSchemaTest, hash)
+{
+    EXPECT_EQ(FieldSchema::hash(std::string("radius")), FieldSchema::hash("radius"));
+    EXPECT_NE(FieldSchema::hash("radius"), FieldSchema::hash("radiuS"));
+}
+
+TEST(FieldSchemaTest, decode)
+{
+    const YAML::Node node = YAML::Load(
+            "{? [name]: x, ids: [1, 2], other: 3, radius: 0.5, name: left, name: right}");
+    Wheel wheel;
+    EXPECT_TRUE(Parser::read<Wheel>(node, wheel));
+    EXPECT_EQ(wheel.name, "left"); // first of duplicate keys
+    EXPECT_EQ(wheel.radius, 0.5f);
+    EXPECT_EQ(wheel.ids, std::vector<int>({1, 2}));
+    EXPECT_EQ(wheel.offset, -1.0); // optional and missing
+    EXPECT_TRUE(Parser::is<Wheel>(node));
+
+    YAML::Node bad_optional = YAML::Clone(node);
+    bad_optional["offset"] = "abc";
+    EXPECT_TRUE(Parser::read<Wheel>(bad_optional, wheel));
+    EXPECT_TRUE(Parser::is<Wheel>(bad_optional));
+    bad_optional["offset"] = "2.5";
+    EXPECT_TRUE(Parser::read<Wheel>(bad_optional, wheel));
+    EXPECT_EQ(wheel.offset, 2.5);
+
+    /* round trip */
+    Wheel decoded;
+    EXPECT_TRUE(Parser::read<Wheel>(YAML::Load(YAML::Dump(YAML::Node(wheel))), decoded));
+    EXPECT_EQ(decoded.name, wheel.name);
+    EXPECT_EQ(decoded.radius, wheel.radius);
+    EXPECT_EQ(decoded.ids, wheel.ids);
+    EXPECT_EQ(decoded.offset, wheel.offset);
+    EXPECT_EQ(YAML::Dump(YAML::Node(wheel)),
+              "name: left\nradius: 0.5\nids:\n  - 1\n  - 2\noffset: 2.5");
+}
+
+TEST(FieldSchemaTest, errors)
+{
+    /* same errors as reading each field with Parser2::read in schema order */
+    const std::vector<std::string> documents{
+            "{name: a, radius: 1, ids: [1]}",
+            "{radius: x, ids: [1]}",
+            "{name: a, radius: x}",
+            "{name: a, radius: 1, ids: [x]}",
+            "{name: [a], radius: 1, ids: [1]}",
+            "[1, 2]",
+            "~"};
+    for ( const std::string& document : documents )
+    {
+        const YAML::Node node = YAML::Load(document);
+        BufferedErrorSink expected_errors;
+        Wheel expected;
+        const bool expected_success = (
+                Parser::read(node, "name", expected.name, &expected_errors) &&
+                Parser::read(node, "radius", expected.radius, &expected_errors) &&
+                Parser::read(node, "ids", expected.ids, &expected_errors) );
+        const std::string no_detail;
+        expected_errors.report(kelo::yaml_common::Error(ErrorCode::BAD_VALUE, no_detail));
+
+        BufferedErrorSink errors;
+        Wheel wheel;
+        EXPECT_EQ(Parser::read<Wheel>(node, wheel, &errors), expected_success) << document;
+        EXPECT_EQ(Parser::is<Wheel>(node), expected_success) << document;
+        if ( !expected_success )
+        {
+            EXPECT_EQ(errors.messages(), expected_errors.messages()) << document;
+        }
+    }
+}
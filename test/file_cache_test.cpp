@@ -0,0 +1,143 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/FileCache.h>
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::FileCache;
+using kelo::yaml_common::FrozenTree;
+
+TEST(FileCacheTest, loadFile)
+{
+    const std::string file_path = testing::TempDir() + "file_cache_test.yaml";
+    std::ofstream(file_path) << "a: 1\n";
+
+    FileCache file_cache;
+    Parser::setFileCache(&file_cache);
+
+    YAML::Node node;
+    EXPECT_TRUE(Parser::loadFile(file_path, node));
+    EXPECT_EQ(Parser::get<int>(node, "a", 0), 1);
+    EXPECT_EQ(file_cache.numOfMisses(), 1u);
+    EXPECT_EQ(file_cache.numOfHits(), 0u);
+
+    // hit returns a copy of the cached node, also through a non-canonical path
+    YAML::Node cached_node;
+    EXPECT_TRUE(Parser::loadFile(testing::TempDir() + "./file_cache_test.yaml",
+                                 cached_node));
+    EXPECT_FALSE(cached_node.is(node));
+    EXPECT_EQ(Parser::get<int>(cached_node, "a", 0), 1);
+    EXPECT_EQ(file_cache.numOfHits(), 1u);
+    EXPECT_EQ(file_cache.size(), 1u);
+
+    // nodes returned by loads and hits do not share the cached node
+    node["a"] = 2;
+    cached_node["a"] = 3;
+    YAML::Node other_node;
+    EXPECT_TRUE(Parser::loadFile(file_path, other_node));
+    EXPECT_EQ(Parser::get<int>(other_node, "a", 0), 1);
+    EXPECT_EQ(file_cache.numOfHits(), 2u);
+
+    // a modified file is parsed again without changing the old node
+    std::ofstream(file_path) << "a: 22\n";
+    YAML::Node new_node;
+    EXPECT_TRUE(Parser::loadFile(file_path, new_node));
+    EXPECT_EQ(Parser::get<int>(new_node, "a", 0), 22);
+    EXPECT_EQ(Parser::get<int>(node, "a", 0), 2);
+    EXPECT_EQ(file_cache.numOfMisses(), 2u);
+
+    // explicit invalidation
+    EXPECT_TRUE(file_cache.invalidate(file_path));
+    EXPECT_FALSE(file_cache.invalidate(file_path));
+    EXPECT_TRUE(Parser::loadFile(file_path, node));
+    EXPECT_FALSE(node.is(new_node));
+    EXPECT_EQ(file_cache.numOfMisses(), 3u);
+
+    // failures are not cached
+    EXPECT_FALSE(Parser::loadFile(file_path + ".missing", node, false));
+    EXPECT_EQ(file_cache.size(), 1u);
+    file_cache.clear();
+    EXPECT_EQ(file_cache.size(), 0u);
+
+    // concurrent loads
+    std::vector<std::thread> threads;
+    std::vector<int> values(8, 0);
+    for ( size_t i = 0; i < values.size(); i++ )
+    {
+        threads.emplace_back([&file_path, &values, i]()
+        {
+            for ( size_t j = 0; j < 100; j++ )
+            {
+                YAML::Node thread_node;
+                Parser::loadFile(file_path, thread_node);
+                values[i] = Parser::get<int>(thread_node, "a", 0);
+            }
+        });
+    }
+    for ( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+    EXPECT_EQ(values, std::vector<int>(8, 22));
+    EXPECT_EQ(file_cache.numOfHits() + file_cache.numOfMisses(), 806u);
+
+    Parser::setFileCache(nullptr);
+    std::remove(file_path.c_str());
+}
+
+TEST(FileCacheTest, loadFrozenFile)
+{
+    const std::string file_path = testing::TempDir() + "file_cache_frozen_test.yaml";
+    std::ofstream(file_path) << "a: 1\n";
+
+    // without a cache every load parses the file
+    std::shared_ptr<const FrozenTree> tree;
+    std::shared_ptr<const FrozenTree> other_tree;
+    EXPECT_TRUE(Parser::loadFile(file_path, tree));
+    EXPECT_TRUE(Parser::loadFile(file_path, other_tree));
+    EXPECT_NE(tree, other_tree);
+    EXPECT_EQ(Parser::get<int>(tree->root(), "a", 0), 1);
+
+    FileCache file_cache;
+    Parser::setFileCache(&file_cache);
+
+    // hits share the cached tree
+    EXPECT_TRUE(Parser::loadFile(file_path, tree));
+    EXPECT_TRUE(Parser::loadFile(file_path, other_tree));
+    EXPECT_EQ(tree, other_tree);
+    EXPECT_EQ(file_cache.find(FileCache::makeKey(file_path)), tree);
+    EXPECT_EQ(file_cache.numOfMisses(), 1u);
+    EXPECT_EQ(file_cache.numOfHits(), 2u);
+
+    // YAML::Node loads get a mutable copy of the cached tree
+    YAML::Node node;
+    EXPECT_TRUE(Parser::loadFile(file_path, node));
+    node["a"] = 2;
+    EXPECT_EQ(Parser::get<int>(tree->root(), "a", 0), 1);
+    EXPECT_EQ(file_cache.numOfHits(), 3u);
+
+    // a modified file is parsed again, old trees stay valid
+    std::ofstream(file_path) << "a: 22\n";
+    EXPECT_TRUE(Parser::loadFile(file_path, other_tree));
+    EXPECT_NE(tree, other_tree);
+    EXPECT_EQ(Parser::get<int>(other_tree->root(), "a", 0), 22);
+    EXPECT_EQ(Parser::get<int>(tree->root(), "a", 0), 1);
+    EXPECT_EQ(file_cache.numOfMisses(), 2u);
+
+    // failures leave the tree untouched and are not cached
+    EXPECT_FALSE(Parser::loadFile(file_path + ".missing", other_tree, false));
+    EXPECT_EQ(Parser::get<int>(other_tree->root(), "a", 0), 22);
+    EXPECT_EQ(file_cache.size(), 1u);
+
+    Parser::setFileCache(nullptr);
+    std::remove(file_path.c_str());
+}
@@ -0,0 +1,183 @@
+#include <atomic>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/Parser2.h>
+
+#ifdef USE_GEOMETRY_COMMON
+#include <geometry_common/Point2D.h>
+#endif // USE_GEOMETRY_COMMON
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::BufferedErrorSink;
+using kelo::yaml_common::ErrorCode;
+using kelo::yaml_common::FrozenNode;
+using kelo::yaml_common::FrozenTree;
+
+TEST(FrozenNodeTest, structure)
+{
+    const YAML::Node node = YAML::Load(
+            "{i: 5, s: !!str 12, n: ~, v: [1, [2, 3]], m: {k: 1}, [a]: b}");
+    const FrozenTree tree(node);
+    const FrozenNode root = tree.root();
+
+    EXPECT_EQ(root.isMap(), true);
+    EXPECT_EQ(root.size(), 6u);
+    EXPECT_EQ(root.key(0).scalar(), "i");
+    EXPECT_EQ(root.value(0).scalar(), "5");
+    EXPECT_EQ(root.find("s").tag(), node["s"].Tag());
+    EXPECT_EQ(root.find("n").isNull(), true);
+    EXPECT_EQ(root.find("v").isSequence(), true);
+    EXPECT_EQ(root.find("v")[1][0].scalar(), "2");
+    EXPECT_EQ(root.find("v")[2].isDefined(), false);
+    EXPECT_EQ(root.key(5).isSequence(), true);
+    EXPECT_EQ(root.value(6).isDefined(), false);
+    EXPECT_EQ(root.find("missing").isDefined(), false);
+    EXPECT_EQ(root.find("i").find("i").isDefined(), false);
+    EXPECT_EQ(FrozenNode().scalar(), "");
+
+    EXPECT_EQ(YAML::Dump(root.thaw()), YAML::Dump(node));
+    EXPECT_EQ(FrozenTree(YAML::Node()).root().isNull(), true);
+    EXPECT_EQ(FrozenTree(node["missing"]).root().isDefined(), false);
+}
+
+TEST(FrozenNodeTest, wideMap)
+{
+    YAML::Node node;
+    for ( int i = 0; i < 100; i++ )
+    {
+        node["key_" + std::to_string(i)] = i;
+    }
+    /* the first of duplicate keys wins, like in YAML::Node::operator[] */
+    node = YAML::Load(YAML::Dump(node) + "\nkey_7: 700\n");
+    const FrozenTree tree(node);
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        const std::string key = "key_" + std::to_string(i);
+        EXPECT_EQ(Parser::get<int>(tree.root(), key, -1), node[key].as<int>()) << key;
+    }
+    EXPECT_EQ(Parser::get<int>(tree.root(), "key_7", -1), 7);
+    EXPECT_EQ(Parser::hasKey(tree.root(), "key_100", false), false);
+    EXPECT_EQ(Parser::hasKey(tree.root(), "key", false), false);
+    EXPECT_EQ(Parser::hasKey(tree.root(), "z", false), false);
+}
+
+TEST(FrozenNodeTest, read)
+{
+    const YAML::Node node = YAML::Load(
+            "{i: 5, f: 5.5, b: on, s: abc, n: ~, v: [1, 2], bad: [1, x], "
+            "m: {k: 1}, mm: {a: {b: 1}, c: {d: 2}}}");
+    const FrozenTree tree(node);
+    const FrozenNode root = tree.root();
+
+    int test_int = 2;
+    EXPECT_EQ(Parser::read<int>(root, "i2", test_int, false), false);
+    EXPECT_EQ(Parser::read<int>(root, "s", test_int, false), false);
+    EXPECT_EQ(test_int, 2);
+    EXPECT_EQ(Parser::read<int>(root, "i", test_int), true);
+    EXPECT_EQ(test_int, 5);
+    EXPECT_EQ(Parser::has<int>(root, "i"), true);
+    EXPECT_EQ(Parser::has<int>(root, "s"), false);
+    EXPECT_EQ(Parser::has<int>(root, ""), false);
+    EXPECT_EQ(Parser::hasKey(root, "m"), true);
+    EXPECT_EQ(Parser::hasKey(root, "m2", false), false);
+    EXPECT_NEAR(Parser::get<float>(root, "f", 0.0f), 5.5f, 1e-9f);
+    EXPECT_EQ(Parser::get<bool>(root, "b", false), true);
+    EXPECT_EQ(Parser::get<std::string>(root, "n", ""), "null");
+    EXPECT_EQ(Parser::get<std::vector<int>>(root, "v", {}), std::vector<int>({1, 2}));
+    EXPECT_EQ(Parser::get<std::vector<int>>(root, "bad", {3}), std::vector<int>({3}));
+    EXPECT_EQ(Parser::is<std::vector<double>>(root.find("v")), true);
+    EXPECT_EQ(Parser::is<std::vector<double>>(root.find("bad")), false);
+    EXPECT_EQ(Parser::is<std::string>(root.find("m")), false);
+
+    /* types without a direct decoder go through yaml-cpp on a thawed copy */
+    const std::map<std::string, int> expected_map{{"k", 1}};
+    EXPECT_EQ((Parser::get<std::map<std::string, int>>(root, "m", {})), expected_map);
+    EXPECT_EQ((Parser::is<std::map<std::string, int>>(root.find("mm"))), false);
+    EXPECT_EQ((Parser::is<std::map<std::string, std::map<std::string, int>>>(
+                    root.find("mm"))), true);
+
+    std::vector<std::string> keys;
+    EXPECT_EQ(Parser::readAllKeys(root, keys), true);
+    EXPECT_EQ(keys, std::vector<std::string>({"i", "f", "b", "s", "n", "v", "bad",
+                                              "m", "mm"}));
+    EXPECT_EQ(Parser::readAllKeys(root.find("i"), keys, false), false);
+
+#ifdef USE_GEOMETRY_COMMON
+    const FrozenTree point_tree(YAML::Load("{p: {x: 1.5, y: -2}, q: {x: 1}}"));
+    kelo::geometry_common::Point2D point;
+    EXPECT_EQ(Parser::read(point_tree.root(), "p", point), true);
+    EXPECT_NEAR(point.x, 1.5f, 1e-6f);
+    EXPECT_NEAR(point.y, -2.0f, 1e-6f);
+    EXPECT_EQ(Parser::has<kelo::geometry_common::Point2D>(point_tree.root(), "q"), false);
+#endif // USE_GEOMETRY_COMMON
+}
+
+TEST(FrozenNodeTest, errors)
+{
+    const YAML::Node node = YAML::Load("{i: 5, s: abc}");
+    const FrozenTree tree(node);
+
+    BufferedErrorSink frozen_errors;
+    BufferedErrorSink errors;
+    int value = 0;
+    for ( const std::string key : {"", "missing", "s"} )
+    {
+        Parser::read(tree.root(), key, value, &frozen_errors);
+        Parser::read(node, key, value, &errors);
+    }
+    Parser::read(tree.root().find("i"), "k", value, &frozen_errors);
+    Parser::read(node["i"], "k", value, &errors);
+    EXPECT_EQ(frozen_errors.codes(), errors.codes());
+    EXPECT_EQ(frozen_errors.codes().size(), 5u);
+}
+
+TEST(FrozenNodeTest, concurrentReads)
+{
+    YAML::Node node;
+    for ( int i = 0; i < 64; i++ )
+    {
+        node["speed_" + std::to_string(i)] = 0.5 * i;
+        node["limits_" + std::to_string(i)].push_back(i);
+        node["limits_" + std::to_string(i)].push_back(-i);
+    }
+    const std::shared_ptr<const FrozenTree> tree = std::make_shared<const FrozenTree>(node);
+
+    std::atomic<size_t> num_of_failures{0};
+    std::vector<std::thread> threads;
+    for ( size_t t = 0; t < 4; t++ )
+    {
+        threads.emplace_back([tree, &num_of_failures]()
+        {
+            for ( int round = 0; round < 200; round++ )
+            {
+                for ( int i = 0; i < 64; i++ )
+                {
+                    const std::string suffix = std::to_string(i);
+                    const std::vector<int> limits = Parser::get<std::vector<int>>(
+                            tree->root(), "limits_" + suffix, {});
+                    if ( Parser::get<double>(tree->root(), "speed_" + suffix, -1.0) != 0.5 * i ||
+                         Parser::has<int>(tree->root(), "missing_" + suffix) ||
+                         limits != std::vector<int>({i, -i}) )
+                    {
+                        num_of_failures++;
+                    }
+                }
+            }
+        });
+    }
+    for ( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+    EXPECT_EQ(num_of_failures.load(), 0u);
+}
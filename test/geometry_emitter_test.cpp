@@ -0,0 +1,110 @@
+#ifdef USE_GEOMETRY_COMMON
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+
+#include <geometry_common/Box2D.h>
+#include <geometry_common/Box3D.h>
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Point3D.h>
+#include <geometry_common/XYTheta.h>
+#include <geometry_common/Pose2D.h>
+#include <geometry_common/Circle.h>
+#include <geometry_common/TransformMatrix2D.h>
+#include <geometry_common/TransformMatrix3D.h>
+#include <geometry_common/LineSegment2D.h>
+#include <geometry_common/Polyline2D.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/PointCloudProjector.h>
+
+using kelo::geometry_common::Box2D;
+using kelo::geometry_common::Box3D;
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::XYTheta;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::Circle;
+using kelo::geometry_common::TransformMatrix2D;
+using kelo::geometry_common::TransformMatrix3D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::Polyline2D;
+using kelo::geometry_common::Polygon2D;
+using Config = kelo::PointCloudProjectorConfig;
+
+using Parser = kelo::yaml_common::Parser2;
+
+/**
+ * @brief Expect direct emission of `value` to match emission of its node, in
+ * block and in flow style, and to read back to `value`
+ */
+template <typename T>
+static void expectSameAsNode(const T& value)
+{
+    YAML::Emitter direct;
+    direct << YAML::BeginMap << YAML::Key << "value" << YAML::Value << value << YAML::EndMap;
+    YAML::Emitter from_node;
+    from_node << YAML::BeginMap << YAML::Key << "value" << YAML::Value << YAML::Node(value)
+              << YAML::EndMap;
+    EXPECT_TRUE(direct.good());
+    EXPECT_EQ(std::string(direct.c_str()), std::string(from_node.c_str()));
+
+    YAML::Emitter direct_flow;
+    direct_flow << YAML::Flow << value;
+    YAML::Emitter from_node_flow;
+    from_node_flow << YAML::Flow << YAML::Node(value);
+    EXPECT_EQ(std::string(direct_flow.c_str()), std::string(from_node_flow.c_str()));
+
+    T read_value;
+    EXPECT_TRUE(Parser::read<T>(YAML::Load(direct.c_str()), "value", read_value));
+    EXPECT_EQ(read_value, value);
+}
+
+TEST(GeometryEmitterTest, sameAsNode)
+{
+    expectSameAsNode(Box2D(1.0f, 2.0f, -3.5f, 4.25f));
+    expectSameAsNode(Box3D(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f));
+    expectSameAsNode(Point2D(0.1f, -2.0f));
+    expectSameAsNode(Point3D(1.0f / 3, 2.0f, 1e-7f));
+    expectSameAsNode(XYTheta(1.0f, 2.0f, 3.0f));
+    expectSameAsNode(Pose2D(1.0f, 2.0f, 0.5f));
+    expectSameAsNode(Circle(1.0f, 2.0f, 0.5f));
+    expectSameAsNode(TransformMatrix2D(1.0f, 2.0f, 0.5f));
+    expectSameAsNode(TransformMatrix3D(1.0f, 2.0f, 3.0f, 0.1f, 0.2f, 0.3f));
+    expectSameAsNode(LineSegment2D(1.0f, 2.0f, 3.0f, 4.0f));
+    expectSameAsNode(Polyline2D({Point2D(1, 2), Point2D(3, 4)}));
+    expectSameAsNode(Polygon2D({Point2D(1, 2), Point2D(3, 4), Point2D(5, 6)}));
+
+    Config config;
+    config.tf_mat = TransformMatrix3D(1.0f, 2.0f, 3.0f, 0.1f, 0.2f, 0.3f);
+    config.angle_min = -1.5f;
+    config.angle_max = 1.5f;
+    YAML::Emitter direct;
+    direct << config;
+    YAML::Emitter from_node;
+    from_node << YAML::Node(config);
+    EXPECT_EQ(std::string(direct.c_str()), std::string(from_node.c_str()));
+}
+
+TEST(GeometryEmitterTest, flow)
+{
+    YAML::Emitter out;
+    out << YAML::Flow << Point2D(1, 2);
+    EXPECT_EQ(std::string(out.c_str()), "{x: 1, y: 2}");
+
+    /* block sequence of flow maps */
+    YAML::Emitter polygon_out;
+    polygon_out.SetMapFormat(YAML::Flow);
+    polygon_out << Polygon2D({Point2D(1, 2), Point2D(3, 4)});
+    EXPECT_EQ(std::string(polygon_out.c_str()), "- {x: 1, y: 2}\n- {x: 3, y: 4}");
+
+    YAML::Emitter empty_out;
+    empty_out << Polygon2D();
+    EXPECT_EQ(std::string(empty_out.c_str()), "[]");
+}
+
+#endif // USE_GEOMETRY_COMMON
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/IndexedNode.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::IndexedNode;
+
+TEST(IndexedNodeTest, read)
+{
+    YAML::Node node = YAML::Load("{i: 5, f: 5.5, s: abc, v: [1, 2], m: {k: 1}}");
+    IndexedNode indexed_node(node);
+
+    int test_int = 2;
+    EXPECT_EQ(Parser::read<int>(indexed_node, "i2", test_int, false), false);
+    EXPECT_EQ(test_int, 2);
+    EXPECT_EQ(Parser::read<int>(indexed_node, "s", test_int, false), false);
+    EXPECT_EQ(test_int, 2);
+    EXPECT_EQ(Parser::read<int>(indexed_node, "i", test_int), true);
+    EXPECT_EQ(test_int, 5);
+    EXPECT_EQ(Parser::has<int>(indexed_node, "i"), true);
+    EXPECT_EQ(Parser::has<int>(indexed_node, "s"), false);
+    EXPECT_EQ(Parser::has<int>(indexed_node, ""), false);
+    EXPECT_EQ(Parser::hasKey(indexed_node, "m"), true);
+    EXPECT_EQ(Parser::hasKey(indexed_node, "m2", false), false);
+    EXPECT_NEAR(Parser::get<float>(indexed_node, "f", 0.0f), 5.5f, 1e-9f);
+    EXPECT_EQ(Parser::get<std::vector<int>>(indexed_node, "v", {}), std::vector<int>({1, 2}));
+    EXPECT_EQ(Parser::get<std::string>(indexed_node, "s2", "xyz"), "xyz");
+
+    std::vector<std::string> keys;
+    EXPECT_EQ(Parser::readAllKeys(indexed_node, keys), true);
+    EXPECT_EQ(keys, std::vector<std::string>({"i", "f", "s", "v", "m"}));
+
+    IndexedNode indexed_scalar(node["i"]);
+    EXPECT_EQ(Parser::hasKey(indexed_scalar, "i", false), false);
+    EXPECT_EQ(Parser::readAllKeys(indexed_scalar, keys, false), false);
+}
+
+TEST(IndexedNodeTest, consistency)
+{
+    YAML::Node node = YAML::Load("{a: 1, b: 2}");
+    IndexedNode indexed_node(node);
+
+    // changed values are visible without rebuilding
+    node["a"] = 10;
+    EXPECT_EQ(Parser::get<int>(indexed_node, "a", 0), 10);
+
+    // added and removed keys are detected
+    node["c"] = 3;
+    EXPECT_EQ(Parser::get<int>(indexed_node, "c", 0), 3);
+    node.remove("b");
+    EXPECT_EQ(Parser::hasKey(indexed_node, "b", false), false);
+
+    // replacing a key keeps the size, needs an explicit refresh
+    node.remove("c");
+    node["d"] = 4;
+    indexed_node.refresh();
+    EXPECT_EQ(Parser::hasKey(indexed_node, "c", false), false);
+    EXPECT_EQ(Parser::get<int>(indexed_node, "d", 0), 4);
+
+    std::vector<std::string> keys;
+    EXPECT_EQ(Parser::readAllKeys(indexed_node, keys), true);
+    EXPECT_EQ(keys, std::vector<std::string>({"a", "d"}));
+}
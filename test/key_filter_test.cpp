@@ -0,0 +1,144 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/KeyFilter.h>
+#include <yaml_common/Parser.h>
+
+using LegacyParser = kelo::yaml_common::Parser;
+using kelo::yaml_common::KeyFilter;
+
+static YAML::Node copy(const YAML::Node& root, const KeyFilter& filter)
+{
+    YAML::Emitter yaml;
+    yaml << YAML::BeginMap;
+    LegacyParser::copyYaml(root, yaml, filter);
+    yaml << YAML::EndMap;
+    EXPECT_TRUE(yaml.good());
+    return YAML::Load(yaml.c_str());
+}
+
+static const char* robots_yaml =
+        "name: fleet\n"
+        "mesh: fleet.stl\n"
+        "robots:\n"
+        "  - name: a\n"
+        "    mesh: a.stl\n"
+        "    calibration: {offset: 1, mesh: c.stl}\n"
+        "  - name: b\n"
+        "    mesh: b.stl\n"
+        "    calibration: {offset: 2}\n"
+        "limits: [1, 2, 3]\n";
+
+TEST(KeyFilter, empty)
+{
+    KeyFilter filter;
+    EXPECT_TRUE(filter.empty());
+    EXPECT_TRUE(filter.root().empty());
+
+    KeyFilter::Position next;
+    EXPECT_FALSE(filter.skip(filter.root(), "mesh", next));
+    EXPECT_FALSE(filter.skip(filter.root(), 0, next));
+
+    const YAML::Node root = YAML::Load(robots_yaml);
+    YAML::Emitter unfiltered;
+    unfiltered << YAML::BeginMap;
+    LegacyParser::copyYaml(root, unfiltered);
+    unfiltered << YAML::EndMap;
+    EXPECT_EQ(YAML::Dump(copy(root, filter)), YAML::Dump(YAML::Load(unfiltered.c_str())));
+}
+
+TEST(KeyFilter, keysAtAnyDepth)
+{
+    KeyFilter filter;
+    filter.addKey("mesh").addKey("offset");
+    EXPECT_FALSE(filter.empty());
+
+    const YAML::Node copied = copy(YAML::Load(robots_yaml), filter);
+    EXPECT_EQ(copied["name"].as<std::string>(), "fleet");
+    EXPECT_FALSE(copied["mesh"]);
+    ASSERT_EQ(copied["robots"].size(), 2u);
+    for ( size_t i = 0; i < 2; i++ )
+    {
+        EXPECT_TRUE(copied["robots"][i]["name"]);
+        EXPECT_FALSE(copied["robots"][i]["mesh"]);
+        EXPECT_TRUE(copied["robots"][i]["calibration"].IsMap());
+        EXPECT_EQ(copied["robots"][i]["calibration"].size(), 0u);
+    }
+}
+
+TEST(KeyFilter, paths)
+{
+    KeyFilter filter;
+    filter.addPath("robots/*/calibration").addPath("robots/0/mesh")
+          .addPath("limits/1");
+
+    const YAML::Node copied = copy(YAML::Load(robots_yaml), filter);
+    EXPECT_EQ(copied["mesh"].as<std::string>(), "fleet.stl");
+    ASSERT_EQ(copied["robots"].size(), 2u);
+    EXPECT_FALSE(copied["robots"][0]["mesh"]);
+    EXPECT_FALSE(copied["robots"][0]["calibration"]);
+    EXPECT_EQ(copied["robots"][1]["mesh"].as<std::string>(), "b.stl");
+    EXPECT_FALSE(copied["robots"][1]["calibration"]);
+    ASSERT_EQ(copied["limits"].size(), 2u);
+    EXPECT_EQ(copied["limits"][0].as<int>(), 1);
+    EXPECT_EQ(copied["limits"][1].as<int>(), 3);
+
+    /* a path is anchored at the root */
+    KeyFilter nested;
+    nested.addPath("calibration");
+    EXPECT_EQ(copy(YAML::Load(robots_yaml), nested)["robots"][0]["calibration"].size(), 2u);
+
+    /* keys containing the separator */
+    KeyFilter segments;
+    segments.addPath(std::vector<std::string>{"a/b"});
+    const YAML::Node slashed = copy(YAML::Load("a/b: 1\na: {b: 2}\n"), segments);
+    EXPECT_FALSE(slashed["a/b"]);
+    EXPECT_EQ(slashed["a"]["b"].as<int>(), 2);
+}
+
+TEST(KeyFilter, legacySkipKeysOnlyAtRoot)
+{
+    YAML::Emitter yaml;
+    yaml << YAML::BeginMap;
+    LegacyParser::copyYaml(YAML::Load(robots_yaml), yaml, {"mesh", "limits"});
+    yaml << YAML::EndMap;
+
+    const YAML::Node copied = YAML::Load(yaml.c_str());
+    EXPECT_FALSE(copied["mesh"]);
+    EXPECT_FALSE(copied["limits"]);
+    EXPECT_EQ(copied["robots"][0]["mesh"].as<std::string>(), "a.stl");
+    EXPECT_EQ(copied["robots"][0]["calibration"]["mesh"].as<std::string>(), "c.stl");
+
+    /* skip keys are plain keys, "*" is not a wildcard */
+    YAML::Emitter star_yaml;
+    star_yaml << YAML::BeginMap;
+    LegacyParser::copyYaml(YAML::Load("{'*': 1, a: 2, ~: 3}"), star_yaml, {"*"});
+    star_yaml << YAML::EndMap;
+    const YAML::Node star_copied = YAML::Load(star_yaml.c_str());
+    EXPECT_EQ(star_copied.size(), 2u);
+    EXPECT_FALSE(star_copied["*"]);
+    EXPECT_EQ(star_copied["a"].as<int>(), 2);
+    EXPECT_EQ(star_copied["null"].as<int>(), 3);
+
+    /* skip keys match map keys, not sequence indices */
+    YAML::Emitter seq_yaml;
+    seq_yaml << YAML::BeginSeq;
+    LegacyParser::copyYaml(YAML::Load("[a, b, c]"), seq_yaml, {"0"});
+    seq_yaml << YAML::EndSeq;
+    const YAML::Node seq_copied = YAML::Load(seq_yaml.c_str());
+    ASSERT_EQ(seq_copied.size(), 3u);
+    EXPECT_EQ(seq_copied[0].as<std::string>(), "a");
+    EXPECT_EQ(seq_copied[2].as<std::string>(), "c");
+
+    YAML::Emitter key_yaml;
+    key_yaml << YAML::BeginMap;
+    LegacyParser::copyYaml(YAML::Load("{0: a, 1: b}"), key_yaml, {"0"});
+    key_yaml << YAML::EndMap;
+    const YAML::Node key_copied = YAML::Load(key_yaml.c_str());
+    EXPECT_EQ(key_copied.size(), 1u);
+    EXPECT_EQ(key_copied["1"].as<std::string>(), "b");
+}
@@ -0,0 +1,175 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/NumericScalar.h>
+#include <yaml_common/Parser2.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::NumericScalar;
+
+/**
+ * @brief Expect NumericScalar::parse to agree with `YAML::convert<T>::decode`
+ * on success and on the exact bits of the value
+ */
+template <typename T>
+static void expectSameAsYamlCpp(const std::string& str)
+{
+    T expected = T();
+    T value = T();
+    const bool expected_success = YAML::convert<T>::decode(YAML::Node(str), expected);
+    ASSERT_EQ(NumericScalar::parse(str, value), expected_success)
+        << typeid(T).name() << " '" << str << "'";
+    if ( expected_success && !( std::isnan(static_cast<double>(expected)) &&
+                                std::isnan(static_cast<double>(value)) ) )
+    {
+        ASSERT_EQ(std::memcmp(&value, &expected, sizeof(T)), 0)
+            << typeid(T).name() << " '" << str << "'";
+    }
+}
+
+static void expectAllSameAsYamlCpp(const std::string& str)
+{
+    expectSameAsYamlCpp<bool>(str);
+    expectSameAsYamlCpp<signed char>(str);
+    expectSameAsYamlCpp<unsigned char>(str);
+    expectSameAsYamlCpp<short>(str);
+    expectSameAsYamlCpp<unsigned short>(str);
+    expectSameAsYamlCpp<int>(str);
+    expectSameAsYamlCpp<unsigned int>(str);
+    expectSameAsYamlCpp<long>(str);
+    expectSameAsYamlCpp<unsigned long>(str);
+    expectSameAsYamlCpp<long long>(str);
+    expectSameAsYamlCpp<unsigned long long>(str);
+    expectSameAsYamlCpp<float>(str);
+    expectSameAsYamlCpp<double>(str);
+}
+
+TEST(NumericScalarTest, sameAsYamlCpp)
+{
+    const std::vector<std::string> corpus{
+            "", " ", "0", "-0", "+0", "00", "007", "08", "0x", "0x1f", "-0X1F",
+            "0xffffffffffffffff", "0x10000000000000000", "18446744073709551615",
+            "18446744073709551616", "9223372036854775807", "-9223372036854775808",
+            "-9223372036854775809", "2147483648", "-2147483648", "-2147483649",
+            "255", "256", "-128", "-129", "65535", "65536", "1 ", "1\n", " 1", "1 2",
+            "+", "-", ".", "-.", ".5", "5.", "-.5e3", "1e", "1e+", "1e5", "1E+05",
+            "1.5.3", "1,5", "1e400", "-1e400", "1e-400", "1e39", "3.4028235e38",
+            "3.4028236e38", "0.1", "0.10000000000000001", "0.30000000000000004",
+            "123456789012345678901234567890", "0.000000000000000000000000000001",
+            "4.9406564584124654e-324", "2.2250738585072011e-308",
+            "1.7976931348623157e308", "1.7976931348623159e308", "9007199254740993",
+            "9007199254740993e-5", "1e22", "1e23", "1.00000005960464477539",
+            "1801439958322381e1", "16777217", "16777217e1", "1.6777217e-3",
+            "33554431e-10", "3355443e11", "3355443e10",
+            ".inf", ".Inf", ".INF", "+.inf", "-.inf", "-.INF", ".nan", ".NaN", ".NAN",
+            ".iNf", ".inf ", "inf", "nan", "y", "Y", "n", "yes", "Yes", "YES", "yEs",
+            "true", "True", "TRUE", "tRUE", "on", "ON", "off", "Off", "no", "NO",
+            "false", "False", "FALSE", "t", "1", "~", "null"};
+    for ( const std::string& str : corpus )
+    {
+        expectAllSameAsYamlCpp(str);
+    }
+
+    /* random strings over the characters numbers are made of */
+    std::mt19937 rng(1);
+    const std::string alphabet = "0123456789012345678901234567890123456789+-.eExX abfABF";
+    for ( size_t i = 0; i < 20000; i++ )
+    {
+        std::string str(1 + rng() % 10, ' ');
+        for ( char& c : str )
+        {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        expectAllSameAsYamlCpp(str);
+    }
+
+    /* random doubles in all notations and precisions */
+    std::mt19937_64 rng_64(2);
+    for ( size_t i = 0; i < 20000; i++ )
+    {
+        double value;
+        const uint64_t bits = rng_64();
+        std::memcpy(&value, &bits, sizeof(value));
+        if ( std::isnan(value) )
+        {
+            continue;
+        }
+        std::ostringstream stream;
+        stream << std::setprecision(rng_64() % 20);
+        if ( i % 2 == 0 )
+        {
+            stream << std::scientific;
+        }
+        stream << value;
+        expectSameAsYamlCpp<float>(stream.str());
+        expectSameAsYamlCpp<double>(stream.str());
+    }
+
+    /* close to the midpoint between two floats, where rounding to double
+     * first and then to float gives a different float */
+    std::mt19937 rng_32(4);
+    for ( size_t i = 0; i < 2000; i++ )
+    {
+        const float fraction = static_cast<float>(rng_32() % ( 1 << 23 )) / ( 1 << 23 );
+        const float low = std::ldexp(1.0f + fraction, static_cast<int>(rng_32() % 60) - 30);
+        const double midpoint =
+            ( static_cast<double>(low) +
+              std::nextafter(low, std::numeric_limits<float>::infinity()) ) / 2;
+        std::ostringstream stream;
+        stream << std::setprecision(15 + i % 3) << ( ( i % 2 == 0 ) ? std::scientific
+                                                                  : std::defaultfloat )
+               << midpoint;
+        expectSameAsYamlCpp<float>(stream.str());
+    }
+}
+
+TEST(NumericScalarTest, roundTrip)
+{
+    /* values written by yaml-cpp are read back exactly */
+    std::mt19937_64 rng(3);
+    for ( size_t i = 0; i < 20000; i++ )
+    {
+        double value;
+        const uint64_t bits = rng();
+        std::memcpy(&value, &bits, sizeof(value));
+        if ( std::isnan(value) )
+        {
+            continue;
+        }
+        const float float_value = static_cast<float>(i) / ( 1 + rng() % 1000 );
+        double parsed_value;
+        float parsed_float_value;
+        ASSERT_TRUE(NumericScalar::parse(YAML::Node(value).Scalar(), parsed_value));
+        ASSERT_TRUE(NumericScalar::parse(YAML::Node(float_value).Scalar(),
+                                         parsed_float_value));
+        EXPECT_EQ(parsed_value, value);
+        EXPECT_EQ(parsed_float_value, float_value);
+    }
+    const long long min = std::numeric_limits<long long>::min();
+    long long parsed_min;
+    ASSERT_TRUE(NumericScalar::parse(YAML::Node(min).Scalar(), parsed_min));
+    EXPECT_EQ(parsed_min, min);
+}
+
+TEST(NumericScalarTest, parser2)
+{
+    const YAML::Node node = YAML::Load(
+            "{i: 0x1F, u: -1, f: 2.5, d: .inf, b: Yes, c: a, s: [1, 2], n: ~}");
+    EXPECT_EQ(Parser::get<int>(node, "i", 0), 31);
+    EXPECT_EQ(Parser::get<unsigned int>(node, "u", 7u), 7u);
+    EXPECT_EQ(Parser::get<float>(node, "f", 0.0f), 2.5f);
+    EXPECT_EQ(Parser::get<double>(node, "d", 0.0), std::numeric_limits<double>::infinity());
+    EXPECT_TRUE(Parser::get<bool>(node, "b", false));
+    EXPECT_EQ(Parser::get<char>(node, "c", 'z'), 'a');
+    EXPECT_FALSE(Parser::is<int>(node["s"]));
+    EXPECT_FALSE(Parser::is<double>(node["n"]));
+}
@@ -0,0 +1,119 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/FrozenNode.h>
+#include <yaml_common/ParameterRegistry.h>
+
+using kelo::yaml_common::BindingStats;
+using kelo::yaml_common::BufferedErrorSink;
+using kelo::yaml_common::ErrorCode;
+using kelo::yaml_common::FrozenTree;
+using kelo::yaml_common::ParameterRegistry;
+
+TEST(ParameterRegistryTest, bind)
+{
+    ParameterRegistry registry;
+    float max_vel = 0.0f;
+    std::string frame;
+    int sensor_id = 0;
+    std::vector<double> gains;
+    size_t num_of_gain_updates = 0;
+    registry.bind("controller/max_vel", max_vel, 1.0f);
+    registry.bind("frame", frame, std::string("base_link"));
+    registry.bind("sensors/1/id", sensor_id, -1);
+    registry.bind<std::vector<double>>("controller/gains",
+            [&](const std::vector<double>& value)
+            {
+                gains = value;
+                num_of_gain_updates++;
+            },
+            {1.0, 0.0, 0.0});
+    EXPECT_EQ(registry.size(), 4u);
+
+    BufferedErrorSink error_sink;
+    EXPECT_TRUE(registry.update(YAML::Load(
+            "{controller: {max_vel: 2.5, gains: [3, 2, 1]}, sensors: [{id: 4}, {id: 7}]}"),
+            &error_sink));
+    EXPECT_FLOAT_EQ(max_vel, 2.5f);
+    EXPECT_EQ(frame, "base_link");
+    EXPECT_EQ(sensor_id, 7);
+    EXPECT_EQ(gains, (std::vector<double>{3.0, 2.0, 1.0}));
+    EXPECT_EQ(num_of_gain_updates, 1u);
+
+    /* only changed paths are decoded; removed ones get their default */
+    EXPECT_TRUE(registry.update(YAML::Load(
+            "{controller: {max_vel: 3, gains: [3, 2, 1]}, frame: odom, sensors: [{id: 4}]}"),
+            &error_sink));
+    EXPECT_FLOAT_EQ(max_vel, 3.0f);
+    EXPECT_EQ(frame, "odom");
+    EXPECT_EQ(sensor_id, -1);
+    EXPECT_EQ(num_of_gain_updates, 1u);
+
+    /* replacing a parent updates the bindings below it */
+    EXPECT_TRUE(registry.update(YAML::Load("{controller: 5, frame: odom, sensors: [{id: 4}]}"),
+                                &error_sink));
+    EXPECT_FLOAT_EQ(max_vel, 1.0f);
+    EXPECT_EQ(gains, (std::vector<double>{1.0, 0.0, 0.0}));
+    EXPECT_EQ(num_of_gain_updates, 2u);
+    EXPECT_EQ(error_sink.size(), 0u);
+
+    const std::vector<BindingStats> stats = registry.stats();
+    ASSERT_EQ(stats.size(), 4u);
+    EXPECT_EQ(stats[0].path, "controller/max_vel");
+    EXPECT_EQ(stats[0].num_of_decodes, 3u);
+    EXPECT_EQ(stats[1].num_of_decodes, 2u);
+    EXPECT_EQ(stats[2].num_of_decodes, 2u);
+    EXPECT_EQ(stats[3].num_of_decodes, 2u);
+    for ( const BindingStats& binding_stats : stats )
+    {
+        EXPECT_GE(binding_stats.total_decode_time, binding_stats.last_decode_time);
+    }
+}
+
+TEST(ParameterRegistryTest, badValue)
+{
+    ParameterRegistry registry;
+    int count = 3;
+    registry.bind("a/count", count, 0);
+
+    BufferedErrorSink error_sink;
+    EXPECT_FALSE(registry.update(YAML::Load("{a: {count: many}}"), &error_sink));
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(error_sink.size(), 1u);
+    EXPECT_EQ(error_sink.codes(), std::vector<ErrorCode>({ErrorCode::BAD_VALUE_FOR_KEY}));
+    const std::vector<std::string> messages = error_sink.messages();
+    EXPECT_TRUE(!messages.empty() && messages.back().find("a/count") != std::string::npos);
+
+    EXPECT_TRUE(registry.update(YAML::Load("{a: {count: 4}}"), &error_sink));
+    EXPECT_EQ(count, 4);
+}
+
+TEST(ParameterRegistryTest, pendingAndUnbind)
+{
+    ParameterRegistry registry;
+    int a = 0;
+    int b = 0;
+    const size_t id = registry.bind("a", a, -1);
+
+    const auto tree = std::make_shared<const FrozenTree>(YAML::Load("{a: 1, b: 2}"));
+    EXPECT_TRUE(registry.update(tree, nullptr));
+    EXPECT_EQ(a, 1);
+
+    /* bindings added later are decoded on the next update even without change */
+    registry.bind("b", b, -1);
+    EXPECT_TRUE(registry.update(tree, nullptr));
+    EXPECT_EQ(b, 2);
+
+    EXPECT_TRUE(registry.unbind(id));
+    EXPECT_FALSE(registry.unbind(id));
+    EXPECT_TRUE(registry.update(YAML::Load("{a: 5, b: 6}"), nullptr));
+    EXPECT_EQ(a, 1);
+    EXPECT_EQ(b, 6);
+    EXPECT_EQ(registry.size(), 1u);
+}
@@ -1,7 +1,13 @@
+#include <cstdio>
+#include <fstream>
+
 #include <gtest/gtest.h>
 
 #include <yaml-cpp/yaml.h>
 
+#include <yaml_common/AsyncErrorSink.h>
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/Parser.h>
 #include <yaml_common/Parser2.h>
 
 #ifdef USE_GEOMETRY_COMMON
@@ -644,6 +650,60 @@ TEST(Parser2Test, readAllKeys)
     EXPECT_EQ(Parser::readAllKeys(root_node["map"], test_keys), false);
 }
 
+TEST(Parser2Test, forEachKey)
+{
+    const YAML::Node node = YAML::Load("{b: 1, a: 2, c: {d: 3}}");
+
+    std::vector<std::string> visited;
+    EXPECT_EQ(Parser::forEachKey(node, [&visited](const std::string& key)
+                                 { visited.push_back(key); }), true);
+    EXPECT_EQ(visited, std::vector<std::string>({"b", "a", "c"}));
+
+    /* views refer to the scalars held by the node */
+    std::vector<const std::string*> views{nullptr};
+    EXPECT_EQ(Parser::readAllKeys(node, views), true);
+    ASSERT_EQ(views.size(), 4u);
+    EXPECT_EQ(views[0], nullptr);
+    for ( size_t i = 0; i < visited.size(); i++ )
+    {
+        EXPECT_EQ(*views[i + 1], visited[i]);
+    }
+    YAML::const_iterator first = node.begin();
+    EXPECT_EQ(views[1], &first->first.Scalar());
+
+    std::vector<std::string> keys{"existing"};
+    EXPECT_EQ(Parser::readAllKeys(node, keys), true);
+    EXPECT_EQ(keys, std::vector<std::string>({"existing", "b", "a", "c"}));
+
+    kelo::yaml_common::BufferedErrorSink errors;
+    size_t count = 0;
+    auto counter = [&count](const std::string&) { count++; };
+    EXPECT_EQ(Parser::forEachKey(node["a"], counter, &errors), false);
+    EXPECT_EQ(Parser::forEachKey(YAML::Load("{a: 1, [b]: 2, c: 3}"), counter,
+                                 &errors), false);
+    EXPECT_EQ(count, 1u);
+    EXPECT_EQ(errors.codes(), std::vector<kelo::yaml_common::ErrorCode>(
+                {kelo::yaml_common::ErrorCode::NOT_A_MAP,
+                 kelo::yaml_common::ErrorCode::NON_SCALAR_KEY}));
+
+    /* key nodes are visited whatever their type */
+    std::vector<YAML::NodeType::value> key_types;
+    EXPECT_EQ(Parser::forEachKeyNode(YAML::Load("{a: 1, [b]: 2, ~: 3}"),
+                                     [&key_types](const YAML::Node& key)
+                                     { key_types.push_back(key.Type()); }), true);
+    EXPECT_EQ(key_types, std::vector<YAML::NodeType::value>(
+                {YAML::NodeType::Scalar, YAML::NodeType::Sequence,
+                 YAML::NodeType::Null}));
+    EXPECT_EQ(Parser::forEachKeyNode(node["a"], [](const YAML::Node&) {}, &errors),
+              false);
+
+    EXPECT_EQ(kelo::yaml_common::Parser::getAllKeys(node),
+              std::vector<std::string>({"b", "a", "c"}));
+    EXPECT_EQ(kelo::yaml_common::Parser::getAllKeys(node["a"]).size(), 0u);
+    EXPECT_EQ(kelo::yaml_common::Parser::getAllKeys(YAML::Load("{a: 1, ~: 2, c: 3}")),
+              std::vector<std::string>({"a", "null", "c"}));
+}
+
 TEST(Parser2Test, mergeYAML)
 {
     YAML::Node original_node;
@@ -686,6 +746,23 @@ TEST(Parser2Test, sequence)
     EXPECT_EQ(truth_vec, int_vec);
     EXPECT_EQ(Parser::get<std::vector<int>>(node, "a", std::vector<int>({1, 2})), truth_vec);
 
+    /* numeric sequences take the bulk path, same results as yaml-cpp */
+    YAML::Node node_num = YAML::Load("{f: [0.5, -1e3, .inf, 0x1], d: [1.25, 0.10000000000000001],"
+                                     " b: [yes, Off, y], e: [], m: [1, [2]], n: [1, ~]}");
+    std::vector<float> float_vec{1.0f};
+    EXPECT_EQ(Parser::read<std::vector<float>>(node_num, "f", float_vec, false), false);
+    EXPECT_EQ(float_vec, std::vector<float>{1.0f}); // check if value is not overwritten
+    node_num["f"][3] = "1";
+    EXPECT_EQ(Parser::read<std::vector<float>>(node_num, "f", float_vec), true);
+    EXPECT_EQ(float_vec, node_num["f"].as<std::vector<float>>());
+    EXPECT_EQ(Parser::get<std::vector<double>>(node_num, "d", {}),
+              node_num["d"].as<std::vector<double>>());
+    EXPECT_EQ(Parser::get<std::vector<bool>>(node_num, "b", {}),
+              std::vector<bool>({true, false, true}));
+    EXPECT_EQ(Parser::get<std::vector<double>>(node_num, "e", {1.0}), std::vector<double>());
+    EXPECT_EQ(Parser::has<std::vector<double>>(node_num, "m"), false);
+    EXPECT_EQ(Parser::has<std::vector<double>>(node_num, "n"), false);
+
 #ifdef USE_GEOMETRY_COMMON
     YAML::Node node_pt = YAML::Load("[{x: 2.0, y: 3.0}, {x: 5.0, y: 7.0}]");
 
@@ -695,3 +772,385 @@ TEST(Parser2Test, sequence)
     EXPECT_EQ(truth_pt_vec, pt_vec);
 #endif // USE_GEOMETRY_COMMON
 }
+
+TEST(Parser2Test, decode)
+{
+    YAML::Node node = YAML::Load("{i: 5, s: abc, v: [1, 2, x], n: ~}");
+
+    int test_int = 2;
+    EXPECT_EQ(Parser::decode<int>(node["i"], test_int), kelo::yaml_common::DecodeStatus::SUCCESS);
+    EXPECT_EQ(test_int, 5);
+    test_int = 2;
+    EXPECT_EQ(Parser::decode<int>(node["s"], test_int), kelo::yaml_common::DecodeStatus::BAD_CONVERSION);
+    EXPECT_EQ(test_int, 2); // check if value is not overwritten
+    EXPECT_EQ(Parser::decode<int>(node["i2"], test_int), kelo::yaml_common::DecodeStatus::INVALID_NODE);
+    EXPECT_EQ(test_int, 2); // check if value is not overwritten
+
+    std::vector<int> int_vec{7};
+    EXPECT_EQ(Parser::decode<std::vector<int>>(node["v"], int_vec), kelo::yaml_common::DecodeStatus::BAD_CONVERSION);
+    EXPECT_EQ(int_vec, std::vector<int>{7}); // check if value is not overwritten
+
+    std::string test_string;
+    EXPECT_EQ(Parser::decode<std::string>(node["n"], test_string), kelo::yaml_common::DecodeStatus::SUCCESS);
+    EXPECT_EQ(test_string, node["n"].as<std::string>());
+}
+
+TEST(Parser2Test, check)
+{
+    YAML::Node node = YAML::Load("{a: [2, 3, 5], b: [2, x, 5], s: abc, m: {k: 1}}");
+
+    // `has`/`is` must agree with `read` for every node
+    std::vector<int> int_vec;
+    for ( const char* key : {"a", "b", "s", "m", "z"} )
+    {
+        EXPECT_EQ(Parser::has<std::vector<int>>(node, key),
+                  Parser::read<std::vector<int>>(node, key, int_vec, false));
+        std::string test_string;
+        EXPECT_EQ(Parser::has<std::string>(node, key),
+                  Parser::read<std::string>(node, key, test_string, false));
+    }
+
+#ifdef USE_GEOMETRY_COMMON
+    YAML::Node geometry_node = YAML::Load(
+            "{polygon: [{x: 1, y: 2}, {x: 3, y: 4}],\
+              bad_polygon: [{x: 1, y: 2}, {x: 3}],\
+              tf_quat: {x: 1, y: 2, qx: 0, qy: 0, qz: 0, qw: 1},\
+              tf_bad: {x: 1, y: 2, qx: 0}}");
+    EXPECT_EQ(Parser::has<Polygon2D>(geometry_node, "polygon"), true);
+    EXPECT_EQ(Parser::has<Polyline2D>(geometry_node, "polygon"), true);
+    EXPECT_EQ(Parser::has<Polygon2D>(geometry_node, "bad_polygon"), false);
+    EXPECT_EQ(Parser::has<Point2D>(geometry_node, "polygon"), false);
+    EXPECT_EQ(Parser::has<TransformMatrix2D>(geometry_node, "tf_quat"), true);
+    EXPECT_EQ(Parser::has<TransformMatrix2D>(geometry_node, "tf_bad"), false);
+    EXPECT_EQ(Parser::is<LineSegment2D>(YAML::Load("{start: {x: 1, y: 2}, end: {x: 3, y: 4}}")), true);
+    EXPECT_EQ(Parser::is<LineSegment2D>(YAML::Load("{start: {x: 1, y: 2}}")), false);
+#endif // USE_GEOMETRY_COMMON
+}
+
+TEST(Parser2Test, errorSink)
+{
+    using kelo::yaml_common::ErrorCode;
+    YAML::Node node = YAML::Load("{i: 5, s: abc}");
+
+    kelo::yaml_common::BufferedErrorSink buffered_sink;
+    int test_int = 2;
+    EXPECT_EQ(Parser::read<int>(node, "i", test_int, &buffered_sink), true);
+    EXPECT_EQ(buffered_sink.size(), 0u);
+    EXPECT_EQ(Parser::read<int>(node, "i2", test_int, &buffered_sink), false);
+    EXPECT_EQ(Parser::read<int>(node, "s", test_int, &buffered_sink), false);
+    EXPECT_EQ(Parser::read<int>(node, "", test_int, &buffered_sink), false);
+    EXPECT_EQ(Parser::read<int>(node["s"], "i", test_int, &buffered_sink), false);
+    EXPECT_EQ(buffered_sink.codes(), std::vector<ErrorCode>({
+                ErrorCode::MISSING_KEY, ErrorCode::BAD_VALUE,
+                ErrorCode::BAD_VALUE_FOR_KEY, ErrorCode::EMPTY_KEY,
+                ErrorCode::NOT_A_MAP}));
+    EXPECT_EQ(buffered_sink.messages()[0], "Given YAML::Node does not have key i2");
+    EXPECT_EQ(buffered_sink.messages()[2], "Could not read YAML::Node with key s");
+    std::stringstream buffered_out;
+    buffered_sink.flush(buffered_out);
+    EXPECT_EQ(buffered_sink.size(), 0u);
+    EXPECT_NE(buffered_out.str().find("[Parser2] Given key is empty\n"), std::string::npos);
+
+    std::vector<std::string> keys;
+    kelo::yaml_common::CallbackErrorSink callback_sink(
+            [&keys](const kelo::yaml_common::Error& error)
+            {
+                keys.push_back(error.detail());
+            });
+    EXPECT_EQ(Parser::read<int>(node, "i2", test_int, &callback_sink), false);
+    EXPECT_EQ(keys, std::vector<std::string>({"i2"}));
+
+    std::stringstream async_out;
+    {
+        kelo::yaml_common::AsyncErrorSink async_sink(async_out);
+        EXPECT_EQ(Parser::read<int>(node, "i2", test_int, &async_sink), false);
+        async_sink.flush();
+        EXPECT_EQ(async_out.str(), "[Parser2] Given YAML::Node does not have key i2\n");
+        EXPECT_EQ(Parser::hasKey(node, "i3", &async_sink), false);
+    }
+    EXPECT_NE(async_out.str().find("i3"), std::string::npos);
+
+    // legacy `print_error_msg` flag is routed to the default sink
+    kelo::yaml_common::ErrorSink* default_sink = Parser::defaultErrorSink();
+    Parser::setDefaultErrorSink(&buffered_sink);
+    EXPECT_EQ(Parser::read<int>(node, "i2", test_int), false);
+    EXPECT_EQ(Parser::read<int>(node, "i2", test_int, false), false);
+    EXPECT_EQ(Parser::get<int>(node, "i2", 0), 0);
+    Parser::setDefaultErrorSink(default_sink);
+    EXPECT_EQ(buffered_sink.codes(), std::vector<ErrorCode>({ErrorCode::MISSING_KEY}));
+
+#ifdef USE_GEOMETRY_COMMON
+    // errors of nested reads go to the sink of the outer read
+    buffered_sink.clear();
+    Point2D test_point;
+    EXPECT_EQ(Parser::read<Point2D>(YAML::Load("{p: {x: 1}}"), "p", test_point, &buffered_sink), false);
+    EXPECT_EQ(buffered_sink.codes(), std::vector<ErrorCode>({
+                ErrorCode::MISSING_KEY, ErrorCode::BAD_VALUE,
+                ErrorCode::BAD_VALUE_FOR_KEY}));
+    EXPECT_EQ(Parser::read<Point2D>(YAML::Load("{p: {x: 1}}"), "p", test_point, nullptr), false);
+    EXPECT_EQ(buffered_sink.size(), 3u);
+#endif // USE_GEOMETRY_COMMON
+}
+
+/**
+ * @brief Exposes the number of map scans performed by Parser2::find. The
+ * tests link against a build of the library with YAML_COMMON_COUNT_KEY_LOOKUPS
+ * defined.
+ */
+class LookupCountingParser : public kelo::yaml_common::Parser2
+{
+    public:
+
+        static size_t numOfKeyLookups()
+        {
+            return num_of_key_lookups_;
+        }
+};
+
+TEST(Parser2Test, singleKeyLookup)
+{
+    using LegacyParser = kelo::yaml_common::Parser;
+    YAML::Node node = YAML::Load("{a: 1, b: 2.5, s: abc, v: [1, 2], p: [1, 2, 3],\
+                                  t: {high: 1, low: 2}, m: {k: 1}}");
+
+    size_t num_of_lookups = LookupCountingParser::numOfKeyLookups();
+    auto countLookups = [&num_of_lookups]()
+    {
+        size_t diff = LookupCountingParser::numOfKeyLookups() - num_of_lookups;
+        num_of_lookups = LookupCountingParser::numOfKeyLookups();
+        return diff;
+    };
+
+    int test_int = 0;
+    EXPECT_EQ(Parser::read<int>(node, "a", test_int), true);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(Parser::read<int>(node, "z", test_int, false), false);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(Parser::has<int>(node, "a"), true);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(Parser::get<std::vector<int>>(node, "v", {}), std::vector<int>({1, 2}));
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(Parser::hasKey(node, "s"), true);
+    EXPECT_EQ(countLookups(), 1u);
+
+    EXPECT_EQ(LegacyParser::getInt(node, "a"), 1);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_NEAR(LegacyParser::getDouble(node, "b"), 2.5, 1e-9);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(LegacyParser::getString(node, "s"), "abc");
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(LegacyParser::hasMap(node, "m"), true);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(LegacyParser::getLength(node, "v"), 2u);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(LegacyParser::hasPose(node, "p"), true);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(LegacyParser::hasPose(node, "v"), false);
+    EXPECT_EQ(countLookups(), 1u);
+    EXPECT_EQ(LegacyParser::getTime(node, "t"), (1LL << 32) + 2);
+    EXPECT_EQ(countLookups(), 3u); // "t" in node, "low" and "high" in node["t"]
+    EXPECT_EQ(LegacyParser::getInt(node, "z"), 0);
+    EXPECT_EQ(countLookups(), 1u);
+
+#ifdef USE_GEOMETRY_COMMON
+    YAML::Node geometry_node = YAML::Load("{box: {min_x: 1, max_x: 2, min_y: 3, max_y: 4},\
+                                           line: {start: {x: 1, y: 2}, end: {x: 3, y: 4}}}");
+    Box2D box;
+    EXPECT_EQ(Parser::read<Box2D>(geometry_node, "box", box), true);
+    EXPECT_FLOAT_EQ(box.max_y, 4.0f);
+    LineSegment2D line_segment;
+    EXPECT_EQ(Parser::read<LineSegment2D>(geometry_node, "line", line_segment), true);
+    EXPECT_FLOAT_EQ(line_segment.end.x, 3.0f);
+    EXPECT_EQ(Parser::has<Box2D>(geometry_node, "box"), true);
+#endif // USE_GEOMETRY_COMMON
+}
+
+TEST(Parser2Test, mergeYAMLNested)
+{
+    YAML::Node base_node = YAML::Load(
+            "{a: 1, b: {x: 1, y: 2, z: {p: 1}}, c: [1, 2], d: 4, [1, 2]: seq_key}");
+    YAML::Node override_node = YAML::Load(
+            "{b: {y: 3, z: {q: 2}, w: 4}, c: [3], d: ~, e: 5, {k: 1}: map_key}");
+
+    YAML::Node node = Parser::mergeYAML(base_node, override_node);
+    EXPECT_EQ(node.size(), 7u);
+    EXPECT_EQ(Parser::get<int>(node, "a", 0), 1);
+    EXPECT_EQ(Parser::get<int>(node["b"], "x", 0), 1);
+    EXPECT_EQ(Parser::get<int>(node["b"], "y", 0), 3);
+    EXPECT_EQ(Parser::get<int>(node["b"], "w", 0), 4);
+    EXPECT_EQ(Parser::get<int>(node["b"]["z"], "p", 0), 1);
+    EXPECT_EQ(Parser::get<int>(node["b"]["z"], "q", 0), 2);
+    EXPECT_EQ(Parser::get<std::vector<int>>(node, "c", {}), std::vector<int>({3}));
+    EXPECT_EQ(Parser::get<int>(node, "d", 0), 4); // null is ignored
+    EXPECT_EQ(Parser::get<int>(node, "e", 0), 5);
+
+    // order of keys is preserved: base keys first, then new override keys
+    std::vector<std::string> keys;
+    for ( const auto& kv : node )
+    {
+        keys.push_back(kv.first.IsScalar() ? kv.first.Scalar() : "<non-scalar>");
+    }
+    EXPECT_EQ(keys, std::vector<std::string>(
+                {"a", "b", "c", "d", "<non-scalar>", "e", "<non-scalar>"}));
+
+    // input nodes are not changed
+    EXPECT_EQ(base_node["b"].size(), 3u);
+    EXPECT_EQ(override_node["b"].size(), 3u);
+    EXPECT_EQ(Parser::get<int>(base_node, "d", 0), 4);
+}
+
+TEST(Parser2Test, mergeLayers)
+{
+    std::vector<YAML::Node> layers{
+            YAML::Load("{a: 1, b: {x: 1, y: {p: 1}}, c: [1], d: {}, e: 1}"),
+            YAML::Load("{b: {y: {q: 2}, z: 2}, c: ~, d: {k: 2}, e: {m: 2}, [1]: s}"),
+            YAML::Load("~"),
+            YAML::Load("{a: ~, b: {x: 3, y: 3}, e: {n: 3}, f: {}}"),
+            YAML::Load("{b: {y: {r: 4}}, f: {g: 4}, a: 4}")};
+
+    // same result as merging pairwise
+    for ( size_t n = 1; n <= layers.size(); n++ )
+    {
+        std::vector<YAML::Node> stack(layers.begin(), layers.begin() + n);
+        YAML::Node expected = stack.front();
+        for ( size_t i = 1; i < n; i++ )
+        {
+            expected.reset(Parser::mergeYAML(expected, stack[i]));
+        }
+        EXPECT_EQ(YAML::Dump(Parser::mergeLayers(stack)), YAML::Dump(expected));
+    }
+    EXPECT_TRUE(Parser::mergeLayers({}).IsNull());
+
+    std::map<std::string, size_t> origins;
+    YAML::Node node = Parser::mergeLayers(layers, &origins);
+    EXPECT_EQ(Parser::get<int>(node["b"]["y"], "r", 0), 4);
+    EXPECT_EQ(Parser::get<int>(node["b"], "x", 0), 3);
+    EXPECT_EQ(Parser::get<int>(node["e"], "m", 0), 2);
+    EXPECT_EQ(origins, (std::map<std::string, size_t>{
+                {"a", 4}, {"b/x", 3}, {"b/y/r", 4}, {"b/z", 1}, {"c", 0},
+                {"d/k", 1}, {"e/m", 1}, {"e/n", 3}, {"f/g", 4}}));
+
+    // the input layers are not changed
+    EXPECT_EQ(layers[0]["b"]["y"].size(), 1u);
+    EXPECT_EQ(layers[3]["b"]["y"].as<int>(), 3);
+}
+
+TEST(Parser2Test, mergeYAMLInPlace)
+{
+    const std::string base_yaml =
+            "{a: 1, b: {x: 1, y: 2, z: {p: 1}}, c: [1, 2], d: 4, f: {}, [1, 2]: seq_key}";
+    YAML::Node override_node = YAML::Load(
+            "{b: {y: 3, z: {q: 2}, w: 4}, c: [3], d: ~, e: 5, f: {g: 6}, "
+            "{k: 1}: map_key, h: ~, !!str 9: tagged_key, !custom t: custom_key}");
+
+    YAML::Node expected = Parser::mergeYAML(YAML::Load(base_yaml), override_node);
+    YAML::Node node = YAML::Load(base_yaml);
+    YAML::Node untouched = node["b"]["x"];
+    Parser::mergeYAMLInPlace(node, override_node);
+    expected.SetStyle(YAML::EmitterStyle::Flow);
+    EXPECT_EQ(YAML::Dump(node), YAML::Dump(expected));
+    EXPECT_TRUE(node["b"]["x"].is(untouched));
+
+    // base and override do not share nodes afterwards
+    node["b"]["z"]["q"] = 7;
+    node["f"]["g"] = 8;
+    EXPECT_EQ(Parser::get<int>(override_node["b"]["z"], "q", 0), 2);
+    EXPECT_EQ(Parser::get<int>(override_node["f"], "g", 0), 6);
+
+    // non-map nodes are replaced unless the override is null
+    YAML::Node scalar_node = YAML::Load("1");
+    Parser::mergeYAMLInPlace(scalar_node, YAML::Load("~"));
+    EXPECT_EQ(scalar_node.as<int>(), 1);
+    Parser::mergeYAMLInPlace(scalar_node, override_node);
+    EXPECT_EQ(Parser::get<int>(scalar_node, "e", 0), 5);
+}
+
+TEST(Parser2Test, loadFile)
+{
+    const std::string file_path = testing::TempDir() + "parser_2_test_load.yaml";
+    const std::string empty_file_path = testing::TempDir() + "parser_2_test_empty.yaml";
+    const std::string bad_file_path = testing::TempDir() + "parser_2_test_bad.yaml";
+    std::ofstream(file_path) << "a: 1\nb: {c: [1, 2, 3]}\n";
+    std::ofstream(empty_file_path).close();
+    std::ofstream(bad_file_path) << "a: [1, 2\n";
+
+    using kelo::yaml_common::FileLoadMode;
+    for ( FileLoadMode mode : {FileLoadMode::STREAM, FileLoadMode::MEMORY_MAP} )
+    {
+        YAML::Node node;
+        EXPECT_TRUE(Parser::loadFile(file_path, node, mode));
+        EXPECT_EQ(Parser::get<int>(node, "a", 0), 1);
+        EXPECT_EQ(Parser::get<std::vector<int>>(node["b"], "c", {}),
+                  std::vector<int>({1, 2, 3}));
+
+        YAML::Node empty_node;
+        EXPECT_TRUE(Parser::loadFile(empty_file_path, empty_node, mode));
+        EXPECT_TRUE(empty_node.IsNull());
+
+        kelo::yaml_common::BufferedErrorSink error_sink;
+        YAML::Node bad_node;
+        EXPECT_FALSE(Parser::loadFile(bad_file_path, bad_node, mode, &error_sink));
+        EXPECT_FALSE(Parser::loadFile(file_path + ".missing", bad_node, mode,
+                                      &error_sink));
+        EXPECT_EQ(error_sink.codes(), std::vector<kelo::yaml_common::ErrorCode>({
+                    kelo::yaml_common::ErrorCode::PARSE_ERROR,
+                    kelo::yaml_common::ErrorCode::BAD_FILE}));
+        EXPECT_NE(error_sink.messages().back().find(file_path + ".missing"),
+                  std::string::npos);
+    }
+
+    std::remove(file_path.c_str());
+    std::remove(empty_file_path.c_str());
+    std::remove(bad_file_path.c_str());
+}
+
+TEST(Parser2Test, loadFiles)
+{
+    std::vector<std::string> file_paths;
+    for ( size_t i = 0; i < 20; i++ )
+    {
+        file_paths.push_back(testing::TempDir() + "parser_2_test_load_"
+                             + std::to_string(i) + ".yaml");
+        if ( i % 7 == 3 )
+        {
+            std::ofstream(file_paths.back()) << "a: [" << i << "\n";
+        }
+        else if ( i % 7 != 5 )
+        {
+            std::ofstream(file_paths.back()) << "a: " << i << "\n";
+        }
+    }
+
+    for ( size_t num_of_threads : {1, 4, 0} )
+    {
+        std::vector<YAML::Node> nodes;
+        std::vector<bool> is_loaded;
+        kelo::yaml_common::BufferedErrorSink error_sink;
+        EXPECT_FALSE(Parser::loadFiles(file_paths, nodes, is_loaded, num_of_threads,
+                                       kelo::yaml_common::FileLoadMode::STREAM,
+                                       &error_sink));
+        ASSERT_EQ(nodes.size(), file_paths.size());
+        ASSERT_EQ(is_loaded.size(), file_paths.size());
+        std::vector<kelo::yaml_common::ErrorCode> codes;
+        for ( size_t i = 0; i < file_paths.size(); i++ )
+        {
+            EXPECT_EQ(is_loaded[i], i % 7 != 3 && i % 7 != 5);
+            if ( is_loaded[i] )
+            {
+                EXPECT_EQ(Parser::get<int>(nodes[i], "a", -1), static_cast<int>(i));
+            }
+            else
+            {
+                codes.push_back(( i % 7 == 3 )
+                                ? kelo::yaml_common::ErrorCode::PARSE_ERROR
+                                : kelo::yaml_common::ErrorCode::BAD_FILE);
+            }
+        }
+        EXPECT_EQ(error_sink.codes(), codes);
+    }
+
+    for ( const std::string& file_path : file_paths )
+    {
+        std::remove(file_path.c_str());
+    }
+}
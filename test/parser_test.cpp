@@ -0,0 +1,128 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/NumericScalar.h>
+#include <yaml_common/Parser.h>
+
+using LegacyParser = kelo::yaml_common::Parser;
+using kelo::yaml_common::NumericScalar;
+using kelo::yaml_common::ScalarType;
+
+/**
+ * @brief Scalar copy as done by copyYaml before classification, trying each
+ * conversion in turn
+ */
+static void emitScalarByChain(const YAML::Node& node, YAML::Emitter& yaml)
+{
+    if ( node.Tag() == "!" )
+    {
+        yaml << node.as<std::string>();
+    }
+    else if ( LegacyParser::hasInt(node) )
+    {
+        yaml << LegacyParser::getInt(node);
+    }
+    else if ( LegacyParser::hasDouble(node) )
+    {
+        yaml << LegacyParser::getDouble(node);
+    }
+    else if ( LegacyParser::hasBool(node) )
+    {
+        yaml << LegacyParser::getBool(node);
+    }
+    else
+    {
+        yaml << LegacyParser::getString(node);
+    }
+}
+
+static const std::vector<std::string> mixed_scalars{
+        "0", "42", "-7", "+3", "0x1F", "017", "2147483648", "-2147483649",
+        "1.5", "-0.25", ".5", "5.", "1e3", "1E-3", ".inf", "-.Inf", "+.INF",
+        ".nan", ".NaN", "inf", "nan", "1.0e999", "true", "False", "YES", "no",
+        "On", "off", "y", "N", "t", "tRue", "hello", "", " 1", "1 ", "1,5",
+        "-", "+", ".", "0x", "e3", "1e", "1.2.3", "1_000", "~", "null"};
+
+TEST(Parser, classifyMatchesConversionChain)
+{
+    for ( const std::string& scalar : mixed_scalars )
+    {
+        const YAML::Node node(scalar);
+        const NumericScalar::Classification classification =
+            NumericScalar::classify(scalar);
+        ScalarType expected = ScalarType::STRING;
+        if ( LegacyParser::hasInt(node) )
+        {
+            expected = ScalarType::INT;
+            EXPECT_EQ(classification.int_value, LegacyParser::getInt(node)) << scalar;
+        }
+        else if ( LegacyParser::hasDouble(node) )
+        {
+            expected = ScalarType::DOUBLE;
+        }
+        else if ( LegacyParser::hasBool(node) )
+        {
+            expected = ScalarType::BOOL;
+            EXPECT_EQ(classification.bool_value, LegacyParser::getBool(node)) << scalar;
+        }
+        EXPECT_EQ(static_cast<int>(classification.type), static_cast<int>(expected))
+            << "'" << scalar << "'";
+    }
+}
+
+TEST(Parser, copyYamlEmitter)
+{
+    YAML::Node root = YAML::Load(
+            "name: robot\n"
+            "id: 12\n"
+            "ratio: 0.75\n"
+            "enabled: yes\n"
+            "quoted: !\"42\"\n"
+            "nothing: ~\n"
+            "skipped: 1\n"
+            "nested:\n"
+            "  limits: [1, -2.5, .inf, off, text, [0x10, 3e2]]\n"
+            "  points:\n"
+            "    - {x: 1, y: 2.5}\n"
+            "    - {x: -1, y: on}\n");
+    for ( const std::string& scalar : mixed_scalars )
+    {
+        root["scalars"].push_back(scalar);
+    }
+
+    YAML::Emitter copy;
+    copy << YAML::BeginMap;
+    LegacyParser::copyYaml(root, copy, {"skipped"});
+    copy << YAML::EndMap;
+    ASSERT_TRUE(copy.good());
+
+    const YAML::Node copied = YAML::Load(copy.c_str());
+    EXPECT_FALSE(copied["skipped"]);
+    EXPECT_FALSE(copied["nothing"]);
+    EXPECT_EQ(copied["quoted"].as<std::string>(), "42");
+    EXPECT_EQ(copied["enabled"].as<std::string>(), "true");
+    EXPECT_EQ(copied["nested"]["limits"][2].as<std::string>(), ".inf");
+    EXPECT_EQ(copied["nested"]["limits"][3].as<std::string>(), "false");
+    EXPECT_EQ(copied["nested"]["limits"][5][0].as<std::string>(), "16");
+    EXPECT_EQ(copied["nested"]["points"][1]["y"].as<std::string>(), "true");
+
+    ASSERT_EQ(copied["scalars"].size(), mixed_scalars.size());
+    for ( size_t i = 0; i < mixed_scalars.size(); i++ )
+    {
+        YAML::Emitter scalar;
+        emitScalarByChain(root["scalars"][i], scalar);
+        EXPECT_EQ(copied["scalars"][i].Scalar(), YAML::Load(scalar.c_str()).Scalar())
+            << mixed_scalars[i];
+    }
+
+    for ( const char* key : {"name", "id", "ratio", "enabled", "quoted"} )
+    {
+        YAML::Emitter scalar;
+        emitScalarByChain(root[key], scalar);
+        EXPECT_EQ(copied[key].Scalar(), YAML::Load(scalar.c_str()).Scalar()) << key;
+    }
+}
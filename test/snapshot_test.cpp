@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/Parser2.h>
+#include <yaml_common/Snapshot.h>
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::Snapshot;
+
+TEST(SnapshotTest, roundTrip)
+{
+    const std::vector<std::string> documents{
+            "a: 1",
+            "~",
+            "[]",
+            "{}",
+            "plain",
+            "a:\nb: &x {c: 'q', d: !!str 5, e: !foo [1, ~, \"\"]}\nf: *x\ng: [*x, *x]",
+            "? [1, 2]\n: seq_key\n? {k: v}\n: map_key\nlist:\n  - - nested\n    - 2.5\n  - {x: y}",
+            "text: |\n  multi\n  line\nquoted: \"\\u00e9\\t\"\nbinary: !!binary aGVsbG8="};
+
+    for ( const std::string& document : documents )
+    {
+        const YAML::Node node = YAML::Load(document);
+        std::string data;
+        Snapshot::serialize(node, data);
+        YAML::Node loaded_node;
+        ASSERT_TRUE(Snapshot::deserialize(data.data(), data.size(), loaded_node));
+        EXPECT_EQ(YAML::Dump(loaded_node), YAML::Dump(node));
+
+        // truncated or corrupted snapshots are rejected
+        for ( size_t size = 0; size < data.size(); size++ )
+        {
+            YAML::Node bad_node;
+            EXPECT_FALSE(Snapshot::deserialize(data.data(), size, bad_node));
+        }
+    }
+
+    // aliases refer to the same node
+    YAML::Node node = YAML::Load("a: &x {b: 1}\nc: *x");
+    std::string data;
+    Snapshot::serialize(node, data);
+    YAML::Node loaded_node;
+    ASSERT_TRUE(Snapshot::deserialize(data.data(), data.size(), loaded_node));
+    EXPECT_TRUE(loaded_node["a"].is(loaded_node["c"]));
+    EXPECT_FALSE(loaded_node["a"]["b"].is(loaded_node["c"]));
+}
+
+TEST(SnapshotTest, sidecar)
+{
+    using kelo::yaml_common::FileLoadMode;
+    const std::string file_path = testing::TempDir() + "snapshot_test.yaml";
+    const std::string sidecar_path = Snapshot::sidecarPath(file_path);
+    std::remove(sidecar_path.c_str());
+    std::ofstream(file_path) << "a: 1\nb: [x, y]\n";
+
+    // first load parses the file and writes the sidecar
+    YAML::Node node;
+    EXPECT_TRUE(Parser::loadFile(file_path, node, FileLoadMode::SNAPSHOT));
+    EXPECT_EQ(Parser::get<int>(node, "a", 0), 1);
+    YAML::Node sidecar_node;
+    ASSERT_TRUE(Snapshot::loadSidecar(file_path, sidecar_node));
+    EXPECT_EQ(YAML::Dump(sidecar_node), YAML::Dump(node));
+
+    // the sidecar is used as long as it matches the file
+    Snapshot::saveSidecar(file_path, YAML::Load("a: 2"));
+    EXPECT_TRUE(Parser::loadFile(file_path, node, FileLoadMode::SNAPSHOT));
+    EXPECT_EQ(Parser::get<int>(node, "a", 0), 2);
+
+    // a modified file makes the sidecar stale
+    std::ofstream(file_path) << "a: 333\n";
+    EXPECT_FALSE(Snapshot::loadSidecar(file_path, sidecar_node));
+    EXPECT_TRUE(Parser::loadFile(file_path, node, FileLoadMode::SNAPSHOT));
+    EXPECT_EQ(Parser::get<int>(node, "a", 0), 333);
+    EXPECT_TRUE(Snapshot::loadSidecar(file_path, sidecar_node));
+
+    // errors are reported as for the other modes
+    std::ofstream(file_path) << "a: [1\n";
+    EXPECT_FALSE(Parser::loadFile(file_path, node, FileLoadMode::SNAPSHOT, false));
+    std::remove(file_path.c_str());
+    EXPECT_FALSE(Parser::loadFile(file_path, node, FileLoadMode::SNAPSHOT, false));
+    std::remove(sidecar_path.c_str());
+}
@@ -0,0 +1,154 @@
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <yaml_common/ErrorSink.h>
+#include <yaml_common/Parser2.h>
+#include <yaml_common/StreamReader.h>
+
+#ifdef USE_GEOMETRY_COMMON
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Point3D.h>
+#include <geometry_common/Pose2D.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::Pose2D;
+#endif // USE_GEOMETRY_COMMON
+
+using Parser = kelo::yaml_common::Parser2;
+using kelo::yaml_common::StreamReader;
+using kelo::yaml_common::BufferedErrorSink;
+using kelo::yaml_common::ErrorCode;
+
+static const char* const document =
+    "skip: {a: [1, 2], b: {c: [3]}}\n"
+    "? [complex, key]\n"
+    ": ignored\n"
+    "zones:\n"
+    "  first: {ids: [9]}\n"
+    "  restricted:\n"
+    "    ids: [4, 5, 6]\n"
+    "    names: [a, 'b', \"c d\"]\n"
+    "    nested: [[1, 2], [], [3]]\n"
+    "    bad: [1, two, 3]\n"
+    "    scalar: 7\n"
+    "  restricted: {ids: [0]}\n"
+    "ids: [1, 2]\n";
+
+template <typename T>
+static bool readSequence(const std::vector<std::string>& key_path,
+                         std::vector<T>& values,
+                         BufferedErrorSink* error_sink = nullptr)
+{
+    std::istringstream input(document);
+    return StreamReader::readSequence<T>(input, key_path, values, error_sink);
+}
+
+TEST(StreamReaderTest, readSequence)
+{
+    // same result as reading the whole document
+    const YAML::Node node = YAML::Load(document);
+    std::vector<int> ids;
+    EXPECT_TRUE(readSequence<int>({"zones", "restricted", "ids"}, ids));
+    EXPECT_EQ(ids, Parser::get<std::vector<int>>(node["zones"]["restricted"], "ids", {}));
+    EXPECT_EQ(ids, std::vector<int>({4, 5, 6}));
+    EXPECT_TRUE(readSequence<int>({"ids"}, ids));
+    EXPECT_EQ(ids, std::vector<int>({1, 2}));
+
+    std::vector<std::string> names;
+    EXPECT_TRUE(readSequence<std::string>({"zones", "restricted", "names"}, names));
+    EXPECT_EQ(names, std::vector<std::string>({"a", "b", "c d"}));
+
+    std::vector<std::vector<int>> nested;
+    EXPECT_TRUE(readSequence<std::vector<int>>({"zones", "restricted", "nested"}, nested));
+    EXPECT_EQ(nested, std::vector<std::vector<int>>({{1, 2}, {}, {3}}));
+
+    // whole document
+    std::istringstream input("[1.5, 2.5]");
+    std::vector<double> values;
+    EXPECT_TRUE(StreamReader::readSequence<double>(input, {}, values, false));
+    EXPECT_EQ(values, std::vector<double>({1.5, 2.5}));
+
+    // callback may stop early
+    std::istringstream callback_input(document);
+    size_t num_of_calls = 0;
+    EXPECT_TRUE(StreamReader::readSequence<int>(
+                callback_input, {"zones", "restricted", "ids"},
+                [&num_of_calls](int& value)
+                {
+                    num_of_calls++;
+                    return value < 5;
+                }));
+    EXPECT_EQ(num_of_calls, 2u);
+}
+
+TEST(StreamReaderTest, errors)
+{
+    BufferedErrorSink error_sink;
+    std::vector<int> ids;
+    EXPECT_FALSE(readSequence<int>({"zones", "missing", "ids"}, ids, &error_sink));
+    EXPECT_FALSE(readSequence<int>({"zones", "restricted", "scalar"}, ids, &error_sink));
+    EXPECT_FALSE(readSequence<int>({"zones", "restricted"}, ids, &error_sink));
+    EXPECT_FALSE(readSequence<int>({"zones", "restricted", "bad"}, ids, &error_sink));
+    EXPECT_EQ(ids, std::vector<int>({1}));
+    EXPECT_EQ(error_sink.codes(), std::vector<ErrorCode>({
+                ErrorCode::MISSING_KEY,
+                ErrorCode::BAD_VALUE_FOR_KEY,
+                ErrorCode::BAD_VALUE_FOR_KEY,
+                ErrorCode::BAD_VALUE_FOR_KEY}));
+    EXPECT_EQ(error_sink.messages().back(),
+              "Could not read YAML::Node with key zones/restricted/bad[1]");
+    error_sink.clear();
+
+    std::istringstream bad_input("x: [1, 2\na: [1]\n");
+    EXPECT_FALSE(StreamReader::readSequence<int>(bad_input, {"a"}, ids, &error_sink));
+    std::istringstream alias_input("a: &x [1]\nb: *x\n");
+    EXPECT_FALSE(StreamReader::readSequence<int>(alias_input, {"b"}, ids, &error_sink));
+    EXPECT_FALSE(StreamReader::loadSequence<int>("/non/existent.yaml", {"a"}, ids,
+                                                 &error_sink));
+    EXPECT_EQ(error_sink.codes(), std::vector<ErrorCode>({
+                ErrorCode::PARSE_ERROR,
+                ErrorCode::OTHER,
+                ErrorCode::BAD_FILE}));
+}
+
+#ifdef USE_GEOMETRY_COMMON
+TEST(StreamReaderTest, geometry)
+{
+    const std::string points_yaml =
+        "points: [{x: 1, y: 2}, {y: 4, x: 3, z: 5}, {x: 5, x: 9, y: 6},"
+        " {? [x]: 1, x: 7, y: {a: 1}, y: 8}, {x: 0, y: [1]}, {x: 1}, [1, 2], 3]";
+    const YAML::Node node = YAML::Load(points_yaml);
+
+    // each element is accepted exactly when Parser2 accepts it
+    for ( size_t i = 0; i < node["points"].size(); i++ )
+    {
+        std::istringstream input("points: [" + YAML::Dump(node["points"][i]) + "]");
+        std::vector<Point2D> points;
+        Point2D point;
+        const bool expected = Parser::read<Point2D>(node["points"][i], point, false);
+        EXPECT_EQ(StreamReader::readSequence<Point2D>(input, {"points"}, points, false),
+                  expected) << i;
+        if ( expected )
+        {
+            ASSERT_EQ(points.size(), 1u);
+            EXPECT_EQ(points[0], point) << i;
+        }
+    }
+
+    std::istringstream input("polygon: [{x: 1, y: 2, z: 3}, {x: 4, y: 5, z: 6}]\n"
+                             "poses: [{x: 1, y: 2, theta: 0.5}]");
+    std::vector<Point3D> points;
+    EXPECT_TRUE(StreamReader::readSequence<Point3D>(input, {"polygon"}, points));
+    EXPECT_EQ(points, std::vector<Point3D>({Point3D(1, 2, 3), Point3D(4, 5, 6)}));
+
+    input.clear();
+    input.seekg(0);
+    std::vector<Pose2D> poses;
+    EXPECT_TRUE(StreamReader::readSequence<Pose2D>(input, {"poses"}, poses));
+    EXPECT_EQ(poses, std::vector<Pose2D>({Pose2D(1, 2, 0.5)}));
+}
+#endif // USE_GEOMETRY_COMMON